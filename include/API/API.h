@@ -85,13 +85,20 @@ namespace OBody::API {
         New versions will be introduced when breaking changes are made to the API, so that it's feasible to
         update the API without breaking SKSE plugins that were compiled for older versions.
     */
-    enum class PluginAPIVersion { Invalid = 0, v1 = 1, Latest = v1 };
+    enum class PluginAPIVersion { Invalid = 0, v1 = 1, v2 = 2, Latest = v2 };
 
     class IActorChangeEventListener;
     struct PresetCounts;
     enum PresetCategory : uint64_t;
     struct PresetAssignmentInformation;
     struct AssignPresetPayload;
+    struct RegenerateLoadedActorsPayload;
+    struct StageTimings;
+    enum ActorStateFlags : uint32_t;
+    struct PresetInformation;
+    enum ActorChangeEventKind : uint64_t;
+    struct EventListenerSubscription;
+    struct ReloadConfigPayload;
 
     /** See the documentation for `IPluginInterface`, this is its base class purely to make it
         easier to maintain ABI-compatibility.
@@ -189,7 +196,9 @@ namespace OBody::API {
         virtual bool RegisterEventListener(IActorChangeEventListener& eventListener) = 0;
 
         /** This will make OBody stop sending events to `eventListener`,
-            returning whether any listeners were deregistered or not. */
+            returning whether any listeners were deregistered or not.
+            This waits for the events that are being sent to `eventListener` on other threads, if any,
+            so once it returns, OBody won't be calling `eventListener` again, and it can be freed straight away. */
         virtual bool DeregisterEventListener(IActorChangeEventListener& eventListener) = 0;
 
         /** This is used to check whether OBody is sending events to `eventListener` or not. */
@@ -254,6 +263,122 @@ namespace OBody::API {
         virtual bool AssignPresetToActor(Actor* actor, AssignPresetPayload& payload) = 0;
     };
 
+    /** This is the plugin interface of version 2 of the plugin-API, it is everything that `IPluginInterface` is,
+        plus methods which work on many actors at once--such as every NPC in a scene--in a single call,
+        where `IPluginInterface` would take a call, or several, per actor.
+
+        The layout of `IPluginInterface` is frozen, so that a plugin built against this header can still be
+        given an `IPluginInterface` by older versions of OBody; methods are only ever added to this class,
+        or to the versions that come after it, as those are only given to the plugins that ask for them.
+
+        If you request `PluginAPIVersion::v2`, or later, via a `RequestPluginInterface` message,
+        the `IPluginInterface` instance that OBody gives you is an instance of this class,
+        so you can `static_cast` it to an `IPluginInterfaceV2` pointer.
+
+        Unless otherwise stated, all the methods provided by this type are thread-safe.
+    */
+    class IPluginInterfaceV2 : public IPluginInterface {
+    public:
+        /** This is the value of a preset index which signifies the absence of a preset. */
+        static constexpr uint32_t NoPresetIndex = std::numeric_limits<uint32_t>::max();
+
+        /** This is used to query the state of many actors at once.
+            The `actors` parameter points to a contiguous span of `actorCount` actors; an actor may be null.
+
+            If `flagsBuffer` is not null, it must point to a contiguous span of at least `actorCount` elements,
+            and OBody writes the flags of `actors[i]` to `flagsBuffer[i]`; a null actor gets `ActorStateNone`.
+            If `presetIndexBuffer` is not null, it must point to a contiguous span of at least `actorCount`
+            elements, and OBody writes the index of the preset assigned to `actors[i]` to `presetIndexBuffer[i]`,
+            or `NoPresetIndex` if the actor has no preset assigned. See `GetPresetNameOfIndex` for what to make
+            of a preset index.
+
+            The answers are those of the individual methods of `IPluginInterface`, such as `ActorIsProcessed`,
+            but they come from the state OBody keeps for each actor, rather than from RaceMenu, where it can. */
+        virtual void GetActorStates(Actor* const* actors, size_t actorCount, ActorStateFlags* flagsBuffer,
+                                    uint32_t* presetIndexBuffer) = 0;
+
+        /** This is used to find the name of a preset by its index, as written by `GetActorStates`.
+            Preset indexes are separate for each sex, so `isFemale` is the sex of the actor
+            the index was read from, per `ActorStateIsFemale`.
+
+            An index of a preset names the same preset for as long as OBody is ready,
+            so the names of indexes can be looked up once, and cached.
+
+            This returns an empty string if the index doesn't name a preset, such as for `NoPresetIndex`.
+            The `string_view` written to `presetName` points to a null-terminated string, which is guaranteed to remain
+            valid until OBody sends your `IOBodyReadinessEventListener` an `OBodyIsNoLongerReady` event. */
+        virtual void GetPresetNameOfIndex(uint32_t presetIndex, bool isFemale, std::string_view& presetName) = 0;
+
+        /** This is used to enumerate the presets along with their indexes, so that a mod can look them up once
+            and then refer to them by index from there on, rather than by name.
+            This works as `IPluginInterface::GetPresetNames` does, in the same order, except that it places
+            `PresetInformation` instances into your buffer. */
+        virtual size_t GetPresets(PresetCategory category, PresetInformation* buffer, size_t bufferLength,
+                                  size_t offset, size_t limit) = 0;
+
+        /** This is used to assign a preset to an actor by its index, as `IPluginInterface::AssignPresetToActor`
+            does by its name; the `presetName` field of `payload` is ignored.
+            The index is that of a preset for the sex of the actor.
+
+            If the supplied index is `NoPresetIndex` this method will unassign any preset assigned to the actor.
+
+            This returns whether the supplied index names a preset or not.
+            If the supplied index was `NoPresetIndex` this will return `true`. */
+        virtual bool AssignPresetIndexToActor(Actor* actor, uint32_t presetIndex, AssignPresetPayload& payload) = 0;
+
+        /** This will make OBody start sending events to `eventListener`, as `IPluginInterface::RegisterEventListener`
+            does, but only the events that `subscription` asks for; see `EventListenerSubscription`.
+            OBody checks the subscriptions before it prepares the arguments of an event, so the events
+            no listener asks for cost next to nothing.
+
+            If `eventListener` is registered already, this replaces its subscription instead,
+            returning `false`; otherwise this returns `true`.
+            The listener is deregistered by `IPluginInterface::DeregisterEventListener`, as usual,
+            and the same rules about the lifetime of `eventListener` apply. */
+        virtual bool SubscribeEventListener(IActorChangeEventListener& eventListener,
+                                            EventListenerSubscription& subscription) = 0;
+
+        /** This is used to reload OBody's preset distribution config and BodySlide presets from disk, such as
+            after editing them mid-game. Only the files that changed since they were last loaded are read again,
+            off the main thread, after which the rules are compiled again, and take the place of the old ones,
+            on the main thread. The loaded NPCs that the changed rules no longer fit--those whose blacklisting
+            changed, or whose preset the rules would no longer pick--are then regenerated, as by
+            `RegenerateLoadedActors`, and the other actors are left as they are.
+
+            Should the presets have changed, OBody becomes unready, and ready again, around replacing them,
+            so the names of presets are invalidated as usual; the indexes of the presets are kept, though.
+
+            The methods that read the rules or the presets, when called on another thread while the main thread
+            replaces them, wait until it's done, and the replacing waits for the calls already under way,
+            so they never see them halfway replaced. Event-listeners that call back into the plugin-API
+            from within one of those methods don't wait on themselves.
+
+            Once done, OBody calls the `onComplete` callback of `payload`, if any, on the main thread,
+            and sends the "OBody_ConfigReloaded" mod event, with the number of actors regenerated
+            as its numeric argument, or -1 should the reload have failed, such as to an invalid config,
+            in which case the config and presets that were in use stay in use.
+
+            This returns `false`, and does nothing, if OBody is not ready, or if a reload is already under way. */
+        virtual bool ReloadConfig(ReloadConfigPayload& payload) = 0;
+
+        /** This is used to generate the bodies of every loaded NPC at once, such as after changing
+            the distribution rules. The actors are gathered, and their presets chosen, on the main thread,
+            in a task, so this returns before then; the morphs are then applied over the following frames
+            so as not to stall the game. Once they all are, OBody calls the
+            `onComplete` callback of `payload`, if any, on the main thread, and sends the
+            "OBody_LoadedActorsRegenerated" mod event, with the number of actors as its numeric argument.
+            The `IActorChangeEventListener` events are sent for each actor as usual. */
+        virtual void RegenerateLoadedActors(RegenerateLoadedActorsPayload& payload) = 0;
+
+        /** This is used to find out where OBody spends its time, for each of the stages of its work.
+            To use this function, supply a pointer to a contiguous span of `StageTimings` via the `buffer`
+            parameter, and supply the length of that buffer via the `bufferLength` parameter.
+            This function will place as many stages' timings into your buffer as it can,
+            returning the number of stages that OBody times, which may be more than it placed.
+            The timings are counted from the start of the game, or from when they were last reset through Papyrus. */
+        virtual size_t GetStageTimings(StageTimings* buffer, size_t bufferLength) = 0;
+    };
+
     /** This is an interface for receiving events from OBody regarding
         whether OBody is ready for other mods to interact with it via the plugin-API or not.
 
@@ -389,6 +514,106 @@ namespace OBody::API {
         std::string_view presetName;
     };
 
+    struct RegenerateLoadedActorsPayload {
+        enum Flags : uint64_t {
+            None = 0,
+            /** If this bit is set, actors will keep the presets assigned to them, and only those that
+                have none, and have not been processed, will have a preset chosen for them. */
+            KeepAssignedPresets = 1 << 0
+        };
+
+        /** A bitwise combination of flags regarding the regeneration. */
+        Flags flags = Flags::None;
+
+        /** Called once every actor's body has been regenerated, with `context` and the number of actors. */
+        void (*onComplete)(void* context, size_t actorCount) = nullptr;
+
+        /** Passed to `onComplete` as it is. */
+        void* context = nullptr;
+    };
+
+    struct StageTimings {
+        /** The name of the stage, such as "DistributionDecision" or "SKEECalls".
+            This is a null-terminated string that remains valid for as long as OBody is loaded. */
+        const char* stageName;
+        /** How many times the stage ran. */
+        uint64_t count;
+        /** How long the stage's runs took, in total and at most. */
+        uint64_t totalNanoseconds;
+        uint64_t maxNanoseconds;
+        /** Element i counts the runs that took less than 2^i microseconds, bar the last, which counts all the rest. */
+        uint64_t histogram[16];
+    };
+
+    /** This is what `IPluginInterfaceV2::GetPresets` places into its buffer for each preset. */
+    struct PresetInformation {
+        /** The index of the preset, as taken by `IPluginInterfaceV2::AssignPresetIndexToActor`. */
+        uint32_t presetIndex;
+
+        /** The name of the preset. This is a `string_view`, but the string it points to is null-terminated,
+            so it can be used as C-style string.
+            The data that this `string_view` points to is guaranteed to be valid
+            until OBody sends your `IOBodyReadinessEventListener` an `OBodyIsNoLongerReady` event. */
+        std::string_view presetName;
+    };
+
+    /** These identify the events of `IActorChangeEventListener`, for `EventListenerSubscription::eventKinds`. */
+    enum ActorChangeEventKind : uint64_t {
+        ActorChangeEventNone = 0,
+        ActorChangeEventActorGenerated = 1 << 0,
+        ActorChangeEventActorPresetChangedWithoutGeneration = 1 << 1,
+        ActorChangeEventActorClothingUpdate = 1 << 2,
+        ActorChangeEventORefitForcefullyChanged = 1 << 3,
+        ActorChangeEventActorMorphsCleared = 1 << 4,
+        /** Every event, including those that later versions of OBody may introduce. */
+        ActorChangeEventAll = ~uint64_t{0}
+    };
+
+    struct EventListenerSubscription {
+        enum Flags : uint64_t {
+            None = 0,
+            /** If this bit is set, the `OnActorClothingUpdate` events for an actor are collected, rather than sent
+                as they happen, and the listener receives one event per actor per frame, at the start of the next
+                frame, with the flags and payload of the last of them.
+                As the event is sent after the fact, the actor's equipment will have been updated by then. */
+            CoalesceClothingUpdates = 1 << 0
+        };
+
+        /** A bitwise combination of flags regarding the subscription. */
+        Flags flags = Flags::None;
+
+        /** A bitwise combination of the `ActorChangeEventKind`s of the events that the listener receives. */
+        uint64_t eventKinds = ActorChangeEventKind::ActorChangeEventAll;
+
+        /** If `actorCount` isn't zero, the listener only receives events for the actors
+            of this contiguous span of `actorCount` actors. OBody copies what it needs from the span,
+            so it needn't remain valid after `IPluginInterfaceV2::SubscribeEventListener` returns. */
+        Actor* const* actors = nullptr;
+        size_t actorCount = 0;
+    };
+
+    struct ReloadConfigPayload {
+        /** Called once the reload is done, with `context`, whether the reload succeeded,
+            and the number of actors that were regenerated. */
+        void (*onComplete)(void* context, bool succeeded, size_t actorCount) = nullptr;
+
+        /** Passed to `onComplete` as it is. */
+        void* context = nullptr;
+    };
+
+    /** These are the flags that `IPluginInterfaceV2::GetActorStates` writes for each actor. */
+    enum ActorStateFlags : uint32_t {
+        ActorStateNone = 0,
+        /** This bit is set if OBody has processed the actor, per `IPluginInterface::ActorIsProcessed`. */
+        ActorStateIsProcessed = 1 << 0,
+        /** This bit is set if the actor is blacklisted, per `IPluginInterface::ActorIsBlacklisted`. */
+        ActorStateIsBlacklisted = 1 << 1,
+        /** This bit is set if ORefit is applied to the actor, per `IPluginInterface::ActorHasORefitApplied`. */
+        ActorStateHasORefitApplied = 1 << 2,
+        /** This bit is set if the actor is female. */
+        ActorStateIsFemale = 1 << 3
+    };
+
     /** This is an interface for receiving events from OBody regarding the state of actors.
 
         If you want to keep your plugin's state in sync with OBody's state for actors you should
@@ -502,6 +727,15 @@ namespace OBody::API {
                     For the `OnActorGenerated` event specifically, this is guaranteed to be non-null and not empty,
                     for other events this may be null if the actor has no preset applied to them. */
                 const std::string_view presetName;
+
+                /** The index of the preset named by `presetName`, or `IPluginInterfaceV2::NoPresetIndex`
+                    where `presetName` is empty. See `IPluginInterfaceV2::GetPresetNameOfIndex`.
+
+                    This member came with `PluginAPIVersion::v2`, and versions of OBody that predate it
+                    send payloads that end before it, so only read it should OBody have given you
+                    an interface of `PluginAPIVersion::v2` or later, that is, should it have answered
+                    a `RequestPluginInterface` message asking for `PluginAPIVersion::v2`. */
+                const uint32_t presetIndex;
             };
 
             enum Flags : uint64_t {
@@ -547,8 +781,12 @@ namespace OBody::API {
 
                     If this string is null or empty,
                     it means that a preset has been unassigned from the actor
-                    and the actor did not previously have a preset assigned to them. */
+                    and the actor did not previously have a preset assigned to them,
+                    or that the preset they had is no longer loaded, such as after `ReloadConfig`. */
                 const std::string_view presetName;
+
+                /** Refer to the documentation of `presetIndex` for the `OnActorGenerated` event. */
+                const uint32_t presetIndex;
             };
 
             enum Flags : uint64_t {
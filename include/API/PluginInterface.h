@@ -3,11 +3,13 @@
 using Actor = RE::Actor;
 using TESForm = RE::TESForm;
 #include "API.h"
+#include "PresetManager/PresetManager.h"
 
 namespace OBody::API {
-    class PluginInterface : public IPluginInterface {
+    class PluginInterface : public IPluginInterfaceV2 {
     public:
-        PluginInterface(const char* owner, void* context = nullptr);
+        PluginInterface(const char* owner, void* context = nullptr,
+                        ::OBody::API::PluginAPIVersion version = ::OBody::API::PluginAPIVersion::Latest);
 
         virtual ::OBody::API::PluginAPIVersion PluginAPIVersion() override;
         virtual const char* SetOwner(const char* owner) override;
@@ -37,5 +39,26 @@ namespace OBody::API {
 
         virtual void GetPresetAssignedToActor(Actor* actor, PresetAssignmentInformation& payload) override;
         virtual bool AssignPresetToActor(Actor* actor, AssignPresetPayload& payload) override;
+
+        virtual void GetActorStates(Actor* const* actors, size_t actorCount, ActorStateFlags* flagsBuffer,
+                                    uint32_t* presetIndexBuffer) override;
+        virtual void GetPresetNameOfIndex(uint32_t presetIndex, bool isFemale, std::string_view& presetName) override;
+        virtual size_t GetPresets(PresetCategory category, PresetInformation* buffer, size_t bufferLength,
+                                  size_t offset, size_t limit) override;
+        virtual bool AssignPresetIndexToActor(Actor* actor, uint32_t presetIndex,
+                                              AssignPresetPayload& payload) override;
+        virtual bool SubscribeEventListener(IActorChangeEventListener& eventListener,
+                                            EventListenerSubscription& subscription) override;
+        virtual bool ReloadConfig(ReloadConfigPayload& payload) override;
+        virtual void RegenerateLoadedActors(RegenerateLoadedActorsPayload& payload) override;
+        virtual size_t GetStageTimings(StageTimings* buffer, size_t bufferLength) override;
+
+    private:
+        // These do the work of both AssignPresetToActor and AssignPresetIndexToActor, once the preset is found.
+        void UnassignPreset(Actor* a_actor, const AssignPresetPayload& payload);
+        void AssignPreset(Actor* a_actor, const PresetManager::Preset& preset, const AssignPresetPayload& payload);
+
+        // The version that was requested, which is the version we report, even though we implement the latest one.
+        ::OBody::API::PluginAPIVersion version;
     };
 }  // namespace OBody::API
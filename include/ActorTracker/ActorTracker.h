@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Body/ORefit.h"
 #include "PresetManager/PresetManager.h"
 #include <boost/unordered/concurrent_flat_map.hpp>
 
@@ -16,7 +17,15 @@ namespace ActorTracker {
                 // or unequips armour in response to it: it can easily cause an infinite loop of `TESEquipEvent`s,
                 // which would freeze the game until it crashes from a stack overflow.
                 uint32_t actorChangeEventsAreBeingSent : 1;
-                uint32_t unusedSpareBitsForLaterUse : 11;
+                // These mirror the RaceMenu morphs which mark the actor as processed or blacklisted,
+                // and whether ORefit is applied to them, so that we needn't ask RaceMenu on every equip event.
+                // They're only meaningful while `morphFlagsAreKnown` is set, which they aren't after a load,
+                // and we then fall back to asking RaceMenu, mirroring its answers from there on.
+                uint32_t morphFlagsAreKnown : 1;
+                uint32_t isProcessed : 1;
+                uint32_t isBlacklisted : 1;
+                uint32_t isClotheActive : 1;
+                uint32_t unusedSpareBitsForLaterUse : 7;
                 static_assert(PresetManager::AssignedPresetIndex::BitWidth == 20);
                 uint32_t presetIndex : 20;
             };
@@ -37,6 +46,14 @@ namespace ActorTracker {
         static Registry& GetInstance();
 
         boost::concurrent_flat_map<RE::FormID, ActorState> stateForActor;
+        // Worked out whenever an actor's body is generated, and forgotten whenever their morphs are cleared,
+        // or they're unloaded or deleted, as their form-ID may then go to another actor.
+        // This isn't persisted, actors generated in an earlier session having theirs worked out on first use.
+        boost::concurrent_flat_map<RE::FormID, Body::ORefit::Baseline> oRefitBaselineForActor;
+
+        // Drops the entries that nothing would miss, so that the registry, and thus the cosave,
+        // doesn't grow for as long as a playthrough lasts. This has to be called on the main thread.
+        void CollectGarbage();
 
     private:
         static Registry instance;
@@ -0,0 +1,10 @@
+#pragma once
+
+// Benchmarks of OBody's hot paths, run against the game's own actors and forms, and the loaded presets and
+// distribution config, so that a change to any of them can be measured rather than guessed at.
+// They leave what they run against as they found it: the stage timings, the registry, the random generator and the
+// presets in use are untouched. The results are written to OBody.log.
+namespace Benchmark {
+    // Queues the benchmarks to run on the main thread, repeating each of them the given number of times.
+    void Run(uint32_t a_iterations);
+}  // namespace Benchmark
@@ -2,14 +2,64 @@
 
 #include "ActorTracker/ActorTracker.h"
 #include "API/PluginInterface.h"
+#include "Body/ClothingUpdateCoalescer.h"
+#include "Body/ListenerList.h"
+#include "Body/MorphBatch.h"
+#include "Body/ORefit.h"
+#include "Body/RandomSliders.h"
+#include "Instrumentation/Instrumentation.h"
 #include "PresetManager/PresetManager.h"
 #include "SKEE.h"
+#include <boost/unordered/unordered_flat_set.hpp>
 
 namespace Body {
     inline SKSE::RegistrationSet<RE::Actor*, std::string> OnActorGenerated("OnActorGenerated"sv);
     inline SKSE::RegistrationSet<RE::Actor*> OnActorNaked("OnActorNaked"sv);
     inline SKSE::RegistrationSet<RE::Actor*> OnActorRemovingClothes("OnActorRemovingClothes"sv);
 
+    // The armor worn in the slots that ORefit looks at, as of the equip event being processed.
+    struct WornClothing {
+        enum Slot : uint8_t {
+            kBody,
+            kOutergarmentChest,
+            kUndergarmentChest,
+            kOutergarmentPelvis,
+            kUndergarmentPelvis,
+            kTotal
+        };
+
+        // The armor being removed by the equip event, if any, is left out.
+        std::array<RE::TESObjectARMO*, kTotal> slots{};
+        bool removingClothes = false;
+    };
+
+    // The state that we mark an actor's morphs with, as mirrored in their `ActorTracker::ActorState`.
+    struct MorphFlags {
+        bool isProcessed = false;
+        bool isBlacklisted = false;
+        bool isClotheActive = false;
+    };
+
+    // What an actor-change event-listener asked to hear about; see `IPluginInterfaceV2::SubscribeEventListener`.
+    struct ActorChangeEventSubscription {
+        uint64_t eventKinds = ::OBody::API::ActorChangeEventKind::ActorChangeEventAll;
+        bool coalesceClothingUpdates = false;
+        // Null for the listeners that hear about every actor. This is shared by the snapshots of the listeners.
+        std::shared_ptr<const boost::unordered_flat_set<RE::FormID>> actors;
+
+        [[nodiscard]] bool Wants(const uint64_t a_eventKind, const RE::FormID a_formID) const {
+            return (eventKinds & a_eventKind) != 0 && (!actors || actors->contains(a_formID));
+        }
+    };
+
+    // What GenerateActorBody decides to do with an actor, which can be decided apart from doing it.
+    struct GenerationChoice {
+        enum Kind : uint8_t { kNothing, kBlacklist, kPreset };
+
+        Kind kind = kNothing;
+        const PresetManager::Preset* preset = nullptr;
+    };
+
     class OBody {
     public:
         OBody(OBody&&) = delete;
@@ -26,19 +76,39 @@ namespace Body {
         float GetMorph(RE::Actor* a_actor, const char* a_morphName) const;
         void NotifyMorphApplied(RE::Actor* actor) const;
         void ApplyMorphs(RE::Actor* a_actor, bool updateMorphsWithoutTimer, bool applyProcessedMorph = true) const;
+        // Called by the morph scheduler, on the main thread, for the updates that ApplyMorphs left to it.
+        void ApplyScheduledMorphs(RE::Actor* a_actor, bool applyProcessedMorph) const;
 
         void ProcessActorEquipEvent(RE::Actor* a_actor, bool a_removingArmor, const RE::TESForm* a_equippedArmor) const;
 
         void GenerateActorBody(RE::Actor* a_actor, ::OBody::API::IPluginInterface* responsibleInterface) const;
+        // This only reads the actor and the distribution rules, so it can be called from any thread.
+        static GenerationChoice ChooseGeneration(RE::Actor* a_actor);
+        void ApplyGenerationChoice(RE::Actor* a_actor, const GenerationChoice& a_choice,
+                                   ::OBody::API::IPluginInterface* responsibleInterface) const;
+        void BlacklistActor(RE::Actor* a_actor, ::OBody::API::IPluginInterface* responsibleInterface) const;
+        // Regenerates every loaded NPC, or with a_keepAssignedPresets, reapplies their presets like
+        // ReapplyActorMorphs does. The bodies are applied over the following frames through the generation queue,
+        // after which the "OBody_LoadedActorsRegenerated" mod event is sent, and a_onComplete is called,
+        // on the main thread, with the number of actors. This can be called from any thread, as the actors are
+        // gathered, and their presets chosen, in a task on the main thread.
+        void RegenerateLoadedActors(bool a_keepAssignedPresets, ::OBody::API::IPluginInterface* responsibleInterface,
+                                    std::function<void(std::size_t)> a_onComplete = {}) const;
+        // Regenerates the given actors afresh, like RegenerateLoadedActors does without a_keepAssignedPresets,
+        // but without sending the mod event. This has to be called on the main thread.
+        void RegenerateActors(std::vector<RE::NiPointer<RE::Actor>> a_actors,
+                              ::OBody::API::IPluginInterface* responsibleInterface,
+                              std::function<void(std::size_t)> a_onComplete = {}) const;
         void GenerateBodyByName(RE::Actor* a_actor, const std::string& a_name,
                                 ::OBody::API::IPluginInterface* responsibleInterface) const;
-        void GenerateBodyByPreset(RE::Actor* a_actor, PresetManager::Preset& a_preset, bool updateMorphsWithoutTimer,
+        void GenerateBodyByPreset(RE::Actor* a_actor, const PresetManager::Preset& a_preset,
+                                  bool updateMorphsWithoutTimer,
                                   ::OBody::API::IPluginInterface* responsibleInterface) const;
 
-        void ApplySlider(RE::Actor* a_actor, const PresetManager::Slider& a_slider, const char* a_key,
-                         float a_weight) const;
-        void ApplySliderSet(RE::Actor* a_actor, PresetManager::SliderSet& a_sliders, const char* a_key) const;
+        static void ApplyPresetSliders(MorphBatch& a_batch, const PresetManager::PresetSliders& a_sliders,
+                                       const char* a_key);
         void ApplyClothePreset(RE::Actor* a_actor) const;
+        void ApplyClothePreset(MorphBatch& a_batch, const ORefit::Baseline& a_baseline) const;
         void RemoveClothePreset(RE::Actor* a_actor) const;
         void ClearActorMorphs(RE::Actor* a_actor, bool updateMorphsWithoutTimer,
                               ::OBody::API::IPluginInterface* responsibleInterface) const;
@@ -50,17 +120,38 @@ namespace Body {
         static float GetWeight(RE::Actor* a_actor);
 
         bool IsClotheActive(RE::Actor* a_actor) const;
+        static WornClothing GetWornClothing(RE::Actor* a_actor, bool a_removingArmor,
+                                            const RE::TESForm* a_equippedArmor);
         static bool IsNaked(RE::Actor* a_actor, bool a_removingArmor, const RE::TESForm* a_equippedArmor);
+        static bool IsNaked(RE::Actor* a_actor, const WornClothing& a_wornClothing, bool a_removingArmor,
+                            const RE::TESForm* a_equippedArmor);
         static bool IsRemovingClothes(RE::Actor* a_actor, bool a_removingArmor, const RE::TESForm* a_equippedArmor);
         static bool IsFemale(RE::Actor* a_actor);
         bool IsProcessed(RE::Actor* a_actor) const;
         bool IsBlacklisted(RE::Actor* a_actor) const;
 
-        static PresetManager::SliderSet GenerateRandomNippleSliders();
-        static PresetManager::SliderSet GenerateRandomGenitalSliders();
-        PresetManager::SliderSet GenerateClotheSliders(RE::Actor* a_actor) const;
+        // Reads the flags from the actor's state, asking RaceMenu only when they aren't known yet.
+        MorphFlags GetMorphFlags(RE::Actor* a_actor) const;
+        // Asks RaceMenu for the flags, leaving the actor's state be.
+        MorphFlags QueryMorphFlags(RE::Actor* a_actor) const;
+        // For when we've just set every one of the morphs that the flags mirror.
+        static void SetMorphFlags(RE::Actor* a_actor, const MorphFlags& a_flags);
+        // For when we've just set some of them; flags that aren't known are left for RaceMenu to tell us about.
+        template <typename Update>
+        static void UpdateMorphFlags(RE::Actor* a_actor, Update&& a_update) {
+            ActorTracker::Registry::GetInstance().stateForActor.visit(a_actor->formID, [&](auto& entry) {
+                if (entry.second.morphFlagsAreKnown) a_update(entry.second);
+            });
+        }
+        // Has the flags asked for again, e.g. once the distribution key has changed.
+        static void ForgetMorphFlags();
 
-        PresetManager::Slider DeriveSlider(RE::Actor* a_actor, const char* a_morph, float a_target) const;
+        static void ApplyRandomSliders(MorphBatch& a_batch, std::span<const RandomSliders::Rule> a_rules,
+                                       const char* a_key);
+        // Derived from the OBody morphs that the actor will have once the batch is flushed.
+        static ORefit::Baseline DeriveORefitBaseline(const MorphBatch& a_batch);
+        // Returns the baseline from when the actor's body was generated, deriving it from their morphs if need be.
+        ORefit::Baseline GetORefitBaseline(RE::Actor* a_actor) const;
 
         bool BecomingReadyForPluginAPIUsage();
         void ReadyForPluginAPIUsage();
@@ -71,20 +162,54 @@ namespace Body {
         bool DetachEventListener(::OBody::API::IOBodyReadinessEventListener& eventListener);
 
         bool AttachEventListener(::OBody::API::IActorChangeEventListener& eventListener);
+        // Returns whether the listener was attached, rather than having its subscription replaced.
+        bool SubscribeEventListener(::OBody::API::IActorChangeEventListener& eventListener,
+                                    const ActorChangeEventSubscription& subscription);
         bool DetachEventListener(::OBody::API::IActorChangeEventListener& eventListener);
         bool IsEventListenerAttached(::OBody::API::IActorChangeEventListener& eventListener);
 
-        template <typename PrepareArguments, typename EventMethod>
+        // The listeners which coalesce clothing updates are sent those later, by the `ClothingUpdateCoalescer`,
+        // which sends them through here with `a_coalesced` set.
+        template <::OBody::API::ActorChangeEventKind Kind, typename PrepareArguments, typename EventMethod>
         __forceinline void SendActorChangeEvent(RE::Actor* a_actor, PrepareArguments&& prepareArguments,
-                                                EventMethod&& eventMethod) const {
-            std::lock_guard<std::recursive_mutex> lock(actorChangeListenerLock);
+                                                EventMethod&& eventMethod, const bool a_coalesced = false) const {
+            // Most of the time nobody is listening, so we check for that before touching the registry.
+            if (actorChangeEventListeners.IsEmpty()) {
+                return;
+            }
+
+            const auto eventListeners{actorChangeEventListeners.Load()};
+            auto formID = a_actor->formID;
+
+            constexpr bool coalescible{Kind == ::OBody::API::ActorChangeEventActorClothingUpdate};
+            auto isSentNow = [&](const ActorChangeEventSubscription& a_subscription) {
+                return a_subscription.Wants(Kind, formID) &&
+                       (!coalescible || a_subscription.coalesceClothingUpdates == a_coalesced);
+            };
+
+            // Likewise, the listeners often don't care for this event, or this actor,
+            // so we check for that before preparing the arguments.
+            using Entry = decltype(actorChangeEventListeners)::Entry;
+            const bool sendsNow{std::ranges::any_of(*eventListeners, isSentNow, &Entry::subscription)};
+            bool coalesces{false};
+
+            if constexpr (coalescible) {
+                coalesces = !a_coalesced && std::ranges::any_of(
+                                                *eventListeners,
+                                                [&](const ActorChangeEventSubscription& a_subscription) {
+                                                    return a_subscription.coalesceClothingUpdates &&
+                                                           a_subscription.Wants(Kind, formID);
+                                                },
+                                                &Entry::subscription);
+            }
 
-            if (actorChangeEventListeners.empty()) {
+            if (!sendsNow && !coalesces) {
                 return;
             }
 
+            Instrumentation::ScopedTimer const timer{Instrumentation::Stage::EventDispatch};
+
             auto& registry{ActorTracker::Registry::GetInstance()};
-            auto formID = a_actor->formID;
 
             ActorTracker::ActorState fallbackActorState{};
             fallbackActorState.actorChangeEventsAreBeingSent = true;
@@ -102,8 +227,12 @@ namespace Body {
 
             auto arguments = prepareArguments();
 
-            for (auto eventListener : actorChangeEventListeners) {
-                eventMethod(eventListener, a_actor, arguments);
+            for (const auto& [eventListener, subscription] : *eventListeners) {
+                if (isSentNow(subscription)) eventMethod(eventListener, a_actor, arguments);
+            }
+
+            if constexpr (coalescible) {
+                if (coalesces) ClothingUpdateCoalescer::GetInstance().Push(a_actor, arguments.first, arguments.second);
             }
 
             registry.stateForActor.visit(formID,
@@ -126,11 +255,12 @@ namespace Body {
 
         SKEE::IBodyMorphInterface* morphInterface{};
 
-        mutable std::recursive_mutex actorChangeListenerLock;
-        std::vector<::OBody::API::IActorChangeEventListener*> actorChangeEventListeners;
+        ListenerList<::OBody::API::IActorChangeEventListener, ActorChangeEventSubscription> actorChangeEventListeners;
 
+        // This serialises the readiness transitions, so that a listener registering mid-transition is told
+        // about the transition exactly once.
         mutable std::recursive_mutex readinessListenerLock;
-        std::vector<::OBody::API::IOBodyReadinessEventListener*> readinessEventListeners;
+        ListenerList<::OBody::API::IOBodyReadinessEventListener> readinessEventListeners;
 
         // This `IPluginInterface` instance is a special one used to signal to plugin-API event-listeners
         // that a change was effected by OBody's Papyrus functions (the OBodyNative script).
@@ -141,5 +271,21 @@ namespace Body {
 
         OBody() = default;
         ~OBody() = default;
+
+        struct Regeneration {
+            RE::NiPointer<RE::Actor> actor;
+            GenerationChoice choice;
+            // Whether the choice is yet to be made.
+            bool choose = true;
+        };
+
+        // With a_keepAssignedPresets, makes the choice for the actors that are to keep their preset,
+        // or that are to be left alone, leaving the others to be chosen for.
+        void PrepareRegeneration(Regeneration& a_regeneration, bool a_keepAssignedPresets) const;
+        // Calls a_onComplete, on the main thread, once every one of the actors is regenerated.
+        // This has to be called on the main thread, as the choices are made from the rules and presets in use.
+        void Regenerate(std::vector<Regeneration> a_regenerations, bool a_keepAssignedPresets,
+                        ::OBody::API::IPluginInterface* responsibleInterface,
+                        std::function<void(std::size_t)> a_onComplete) const;
     };
 }  // namespace Body
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "API/PluginInterface.h"
+#include <boost/unordered/unordered_flat_map.hpp>
+
+namespace Body {
+    // Equipping an outfit sends an `OnActorClothingUpdate` event for every piece of it, and a busy scene makes
+    // for a lot of them, so the listeners which asked for those events to be coalesced get theirs collected here
+    // instead, the last update for each actor superseding those before it.
+    // The updates are sent once a frame, on the main thread, through SKSE's task interface.
+    class ClothingUpdateCoalescer {
+    public:
+        ClothingUpdateCoalescer(ClothingUpdateCoalescer&&) = delete;
+        ClothingUpdateCoalescer(const ClothingUpdateCoalescer&) = delete;
+
+        ClothingUpdateCoalescer& operator=(ClothingUpdateCoalescer&&) = delete;
+        ClothingUpdateCoalescer& operator=(const ClothingUpdateCoalescer&) = delete;
+
+        static ClothingUpdateCoalescer& GetInstance();
+
+        using Event = ::OBody::API::IActorChangeEventListener::OnActorClothingUpdate;
+
+        void Push(RE::Actor* a_actor, Event::Flags a_flags, const Event::Payload& a_payload);
+
+    private:
+        static ClothingUpdateCoalescer instance;
+
+        ClothingUpdateCoalescer() = default;
+
+        struct PendingUpdate {
+            RE::ActorHandle actorHandle;
+            Event::Flags flags;
+            Event::Payload payload;
+        };
+
+        void Flush();
+
+        std::mutex lock;
+        boost::unordered_flat_map<RE::FormID, PendingUpdate> pendingUpdates;
+        bool flushIsQueued = false;
+    };
+}  // namespace Body
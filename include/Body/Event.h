@@ -3,7 +3,9 @@
 namespace Event {
     class OBodyEventHandler final : public RE::BSTEventSink<RE::TESInitScriptEvent>,
                                     public RE::BSTEventSink<RE::TESLoadGameEvent>,
-                                    public RE::BSTEventSink<RE::TESEquipEvent> {
+                                    public RE::BSTEventSink<RE::TESEquipEvent>,
+                                    public RE::BSTEventSink<RE::TESObjectLoadedEvent>,
+                                    public RE::BSTEventSink<RE::TESFormDeleteEvent> {
     public:
         static OBodyEventHandler* GetSingleton() { return &singleton; }
         static void Register();
@@ -26,6 +28,12 @@ namespace Event {
         RE::BSEventNotifyControl ProcessEvent(const RE::TESEquipEvent* a_event,
                                               RE::BSTEventSource<RE::TESEquipEvent>*) override;
 
+        RE::BSEventNotifyControl ProcessEvent(const RE::TESObjectLoadedEvent* a_event,
+                                              RE::BSTEventSource<RE::TESObjectLoadedEvent>*) override;
+
+        RE::BSEventNotifyControl ProcessEvent(const RE::TESFormDeleteEvent* a_event,
+                                              RE::BSTEventSource<RE::TESFormDeleteEvent>*) override;
+
         OBodyEventHandler() = default;
     };
 }  // namespace Event
@@ -0,0 +1,45 @@
+#pragma once
+
+namespace Body {
+    // Paces a queue's work onto the main thread: once told that there's work, it has the queue's drain run through
+    // SKSE's task interface, at most once a frame. It only ever has the one drain queued, so that the drains can't
+    // pile up in SKSE's task queue should the game's frames take longer than our interval.
+    //
+    // The pacing thread is detached rather than joined, as it would otherwise be joined while the DLL's statics are
+    // destroyed, when SKSE may well be gone, and joining threads under the loader lock is asking for a deadlock.
+    // Being destroyed merely tells it to stop; everything that it touches is shared with it, so it can outlive us.
+    class FramePacer {
+    public:
+        // Called on the main thread, the drain returns whether it left work for the next frame.
+        using Drain = std::function<bool()>;
+
+        explicit FramePacer(Drain a_drain);
+        ~FramePacer();
+
+        FramePacer(FramePacer&&) = delete;
+        FramePacer(const FramePacer&) = delete;
+
+        FramePacer& operator=(FramePacer&&) = delete;
+        FramePacer& operator=(const FramePacer&) = delete;
+
+        // Has the drain run within the next frame or so, unless it's due to run already.
+        void Notify();
+
+    private:
+        struct State {
+            Drain drain;
+            std::mutex lock;
+            std::condition_variable_any workAvailable;
+            bool workIsPending = false;
+            bool drainIsQueued = false;
+        };
+
+        static void Pace(const std::shared_ptr<State>& a_state, const std::stop_token& stopToken);
+
+        std::shared_ptr<State> state;
+        std::stop_source stopSource;
+
+        // Started upon the first notification, as we shouldn't be starting threads while the DLL is being loaded.
+        std::once_flag pacerStarted;
+    };
+}  // namespace Body
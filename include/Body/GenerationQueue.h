@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Body/FramePacer.h"
+
+#include <boost/unordered/unordered_flat_set.hpp>
+
+namespace Body {
+    // Entering a crowded cell initialises the scripts of every NPC in it within a few frames,
+    // and generating all of their bodies right there in the event sink makes for a noticeable stutter.
+    // So, when deferred generation is enabled, the event sink merely queues the actors here,
+    // and their bodies are generated a few at a time, each frame getting a budget of time to spend on them.
+    //
+    // The bodies are generated on the main thread, a batch a frame, as paced by a `FramePacer`.
+    class GenerationQueue {
+    public:
+        GenerationQueue(GenerationQueue&&) = delete;
+        GenerationQueue(const GenerationQueue&) = delete;
+
+        GenerationQueue& operator=(GenerationQueue&&) = delete;
+        GenerationQueue& operator=(const GenerationQueue&) = delete;
+
+        static GenerationQueue& GetInstance();
+
+        // Called on the main thread with the actor, or with null should the actor no longer be valid or loaded.
+        using Job = std::function<void(RE::Actor*)>;
+
+        // Actors are generated in the order they were queued in.
+        // Queueing an actor that's already queued does nothing.
+        void Enqueue(RE::Actor* a_actor);
+        // Queues a job of the caller's own in place of generating the actor as usual. Jobs are never coalesced.
+        void Enqueue(RE::ActorHandle a_actorHandle, Job a_job);
+
+        // Whether the actors whose scripts are initialised are to be queued rather than generated right away.
+        std::atomic<bool> enabled{false};
+        // How long each frame may spend generating bodies. At least one body is generated each frame regardless.
+        std::atomic<uint32_t> budgetPerFrameInMicroseconds{2000};
+
+    private:
+        static GenerationQueue instance;
+
+        GenerationQueue() = default;
+
+        struct PendingGeneration {
+            RE::ActorHandle actorHandle;
+            // Empty for the actors that are to be generated as usual.
+            Job job;
+        };
+
+        void Push(PendingGeneration&& a_pendingGeneration);
+        // Returns whether any actors were left for the next batch.
+        bool GenerateBatch();
+
+        std::mutex lock;
+        std::deque<PendingGeneration> pendingGenerations;
+        // The actors queued to be generated as usual.
+        boost::unordered_flat_set<RE::ActorHandle::native_handle_type> pendingActorHandles;
+
+        FramePacer pacer{[this] { return GenerateBatch(); }};
+    };
+}  // namespace Body
@@ -0,0 +1,112 @@
+#pragma once
+
+namespace Body {
+    // A list of event-listeners that is read on every event but only written when a listener (de)registers,
+    // which hardly ever happens. Writers copy the list, change the copy and publish it in place of the old one,
+    // so that events are sent to an immutable snapshot of the listeners without taking any lock.
+    //
+    // Each listener comes with its subscription, which says what it wants to hear about,
+    // for the lists whose listeners can be choosy.
+    //
+    // Listeners (de)registered while an event is being sent only see the change from the next event onwards,
+    // but Remove doesn't return until the events being sent to the listener are, so that it can be freed right away.
+    template <typename Listener, typename Subscription = std::monostate>
+    class ListenerList {
+    public:
+        struct Entry {
+            Listener* listener;
+            Subscription subscription;
+        };
+
+        // Each snapshot holds on to the one that replaced it, so that a snapshot is only ever destroyed
+        // once every snapshot older than it is, and with them, the events that were being sent to them.
+        struct Listeners : std::vector<Entry> {
+            mutable std::shared_ptr<const Listeners> successor;
+        };
+
+        using Snapshot = std::shared_ptr<const Listeners>;
+
+        // This is cheaper than loading the snapshot, so that sending events nobody listens to costs next to nothing.
+        [[nodiscard]] bool IsEmpty() const { return count.load(std::memory_order_acquire) == 0; }
+
+        [[nodiscard]] Snapshot Load() const { return snapshot.load(std::memory_order_acquire); }
+
+        void Add(Listener* a_listener, Subscription a_subscription = {}) {
+            std::lock_guard guard{writeLock};
+
+            auto listeners{Copy(snapshot.load(std::memory_order_relaxed))};
+            listeners->push_back({a_listener, std::move(a_subscription)});
+            Publish(std::move(listeners));
+        }
+
+        // Replaces the subscription of every entry of the listener, adding it should it have none.
+        // Returns whether the listener was added.
+        bool AddOrReplace(Listener* a_listener, const Subscription& a_subscription) {
+            std::lock_guard guard{writeLock};
+
+            auto listeners{Copy(snapshot.load(std::memory_order_relaxed))};
+
+            bool found{false};
+            for (auto& entry : *listeners) {
+                if (entry.listener != a_listener) continue;
+
+                entry.subscription = a_subscription;
+                found = true;
+            }
+
+            if (!found) listeners->push_back({a_listener, a_subscription});
+
+            Publish(std::move(listeners));
+            return !found;
+        }
+
+        // Mustn't be called while an event is being sent to the listener on the same thread, as it'd never return.
+        bool Remove(Listener* a_listener) {
+            Snapshot replaced;
+            {
+                std::lock_guard guard{writeLock};
+
+                replaced = snapshot.load(std::memory_order_relaxed);
+                auto listeners{Copy(replaced)};
+                auto isRemoved = [&](const Entry& a_entry) { return a_entry.listener == a_listener; };
+                if (std::erase_if(*listeners, isRemoved) == 0) return false;
+
+                Publish(std::move(listeners));
+            }
+
+            // The replaced snapshot can no longer be loaded, and is otherwise only held by the events being sent to
+            // it, or by the snapshot before it, for as long as that one is. So once we hold the last reference to it,
+            // no event is being sent to the listener any longer.
+            while (replaced.use_count() > 1) std::this_thread::yield();
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            return true;
+        }
+
+        [[nodiscard]] bool Contains(Listener* a_listener) const {
+            const auto listeners{Load()};
+            return std::ranges::find(*listeners, a_listener, &Entry::listener) != listeners->end();
+        }
+
+    private:
+        // The copy has the entries of the snapshot, but not its successor.
+        static std::shared_ptr<Listeners> Copy(const Snapshot& a_snapshot) {
+            auto listeners{std::make_shared<Listeners>()};
+            listeners->assign(a_snapshot->begin(), a_snapshot->end());
+            return listeners;
+        }
+
+        void Publish(std::shared_ptr<Listeners>&& a_listeners) {
+            const auto newCount{a_listeners->size()};
+            Snapshot published{std::move(a_listeners)};
+
+            snapshot.load(std::memory_order_relaxed)->successor = published;
+            snapshot.store(std::move(published), std::memory_order_release);
+            count.store(newCount, std::memory_order_release);
+        }
+
+        std::mutex writeLock;
+        std::atomic<Snapshot> snapshot{std::make_shared<const Listeners>()};
+        std::atomic<std::size_t> count{0};
+    };
+}  // namespace Body
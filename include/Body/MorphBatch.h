@@ -0,0 +1,67 @@
+#pragma once
+
+#include "SKEE.h"
+#include "STL.h"
+
+namespace Body {
+    // Collects the morphs that we're about to give an actor, so that RaceMenu only gets told about the ones that
+    // actually change. Generating a body sets a few hundred morphs, and having them cleared first, as we used to,
+    // meant that regenerating an actor with the same preset rewrote every one of them.
+    //
+    // Writes to the same morph and key overwrite each other, the last one winning.
+    // Nothing is written to RaceMenu until the batch is flushed, at which point:
+    // - any morph under a cleared key that the batch didn't set is cleared,
+    // - any morph that already has the value the batch set for it is left untouched,
+    // - and the rest are set.
+    //
+    // A batch is meant to live on the stack, for the duration of a single update to a single actor.
+    // The keys passed to it are kept by pointer, so they have to outlive it, which string literals do.
+    class MorphBatch {
+    public:
+        MorphBatch(RE::Actor* a_actor, SKEE::IBodyMorphInterface* a_morphInterface);
+
+        MorphBatch(MorphBatch&&) = delete;
+        MorphBatch(const MorphBatch&) = delete;
+
+        MorphBatch& operator=(MorphBatch&&) = delete;
+        MorphBatch& operator=(const MorphBatch&) = delete;
+
+        [[nodiscard]] RE::Actor* GetActor() const { return actor; }
+
+        // Clears all the actor's morphs under the given key, bar those that the batch sets.
+        void ClearKey(const char* a_key);
+        // Clears all the actor's morphs, whichever mod they come from, before the batch's morphs are set.
+        void ClearAll();
+
+        void Set(std::string_view a_morphName, const char* a_key, float a_value);
+        // Returns the value that the morph will have once the batch has been flushed.
+        [[nodiscard]] float Get(std::string_view a_morphName, const char* a_key) const;
+
+        // Writes the batch to RaceMenu, leaving the batch empty.
+        void Flush();
+
+    private:
+        struct Entry {
+            std::string morphName;
+            const char* key;
+            float value;
+            // Set during the flush for the morphs that already have the value.
+            bool upToDate = false;
+        };
+
+        static std::string IndexKey(std::string_view a_morphName, std::string_view a_key);
+        [[nodiscard]] bool IsKeyCleared(std::string_view a_key) const;
+
+        void ClearStaleMorphs();
+
+        RE::Actor* actor;
+        SKEE::IBodyMorphInterface* morphInterface;
+
+        std::vector<Entry> entries;
+        // Keyed by the morph's key and name, matched case-insensitively as RaceMenu does.
+        boost::unordered_flat_map<std::string, uint32_t, stl::ihash, stl::iequal_to> entryIndexes;
+
+        std::vector<const char*> clearedKeys;
+        bool clearsAllMorphs = false;
+    };
+}  // namespace Body
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Body/FramePacer.h"
+
+#include <boost/unordered/unordered_flat_map.hpp>
+
+namespace Body {
+    // Having RaceMenu update an actor's morphs is expensive, and when a lot of actors need theirs updated at once,
+    // such as when entering a crowded cell, doing all of them at once makes for a noticeable stutter.
+    // So in performance mode we queue the updates here instead, and apply a few of them each frame,
+    // starting with the actors nearest to the player, as those are the ones most likely to be seen.
+    //
+    // The updates themselves are applied on the main thread, a batch a frame, as paced by a `FramePacer`.
+    class MorphScheduler {
+    public:
+        MorphScheduler(MorphScheduler&&) = delete;
+        MorphScheduler(const MorphScheduler&) = delete;
+
+        MorphScheduler& operator=(MorphScheduler&&) = delete;
+        MorphScheduler& operator=(const MorphScheduler&) = delete;
+
+        static MorphScheduler& GetInstance();
+
+        // Requests for an actor that already has an update pending are coalesced into the pending one,
+        // the latest request deciding whether the actor is to be marked as processed.
+        void Schedule(RE::Actor* a_actor, bool applyProcessedMorph);
+
+        std::atomic<uint32_t> morphUpdatesPerFrame{4};
+
+    private:
+        static MorphScheduler instance;
+
+        MorphScheduler() = default;
+
+        // Returns whether any updates were left for the next batch.
+        bool ApplyBatch();
+
+        struct PendingUpdate {
+            RE::ActorHandle actorHandle;
+            bool applyProcessedMorph;
+        };
+
+        std::mutex lock;
+        boost::unordered_flat_map<RE::ActorHandle::native_handle_type, PendingUpdate> pendingUpdates;
+
+        FramePacer pacer{[this] { return ApplyBatch(); }};
+    };
+}  // namespace Body
@@ -0,0 +1,98 @@
+#pragma once
+
+namespace Body::ORefit {
+    // A slider that ORefit applies, under the OClothe key, while an actor is clothed.
+    // Derived sliders bring a morph to a target value whatever the actor's OBody preset set it to,
+    // so their value is the target minus the actor's OBody morph. The others are interpolated by weight as usual.
+    struct SliderDefinition {
+        const char* name;
+        float min;
+        float max;
+        bool derived = false;
+        // Only applied when ORefit is allowed to touch the nipples.
+        bool nipple = false;
+    };
+
+    consteval SliderDefinition Fixed(const char* a_name, const float a_min, const float a_max,
+                                     const bool a_nipple = false) {
+        return {a_name, a_min, a_max, false, a_nipple};
+    }
+
+    consteval SliderDefinition Fixed(const char* a_name, const float a_value) {
+        return Fixed(a_name, a_value, a_value);
+    }
+
+    consteval SliderDefinition Derived(const char* a_name, const float a_target, const bool a_nipple = false) {
+        return {a_name, a_target, a_target, true, a_nipple};
+    }
+
+    inline constexpr std::array Sliders{
+        // breasts
+        // make area on sides behind breasts not sink in
+        Derived("BreastSideShape", 0.0F),
+        // make area under breasts not sink in
+        Derived("BreastUnderDepth", 0.0F),
+        // push breasts together
+        Derived("BreastCleavage", 1.0F),
+        // push up smaller breasts more
+        Fixed("BreastGravity2", -0.1F, -0.05F),
+        // Make top of breast rise higher
+        Fixed("BreastTopSlope", -0.2F, -0.35F),
+        // push breasts together
+        Fixed("BreastsTogether", 0.3F, 0.35F),
+        // push breasts up
+        // Fixed("PushUp", 0.6f, 0.4f),
+        // Shrink breasts slightly
+        Fixed("Breasts", -0.05F),
+        // Move breasts up on body slightly
+        Fixed("BreastHeight", 0.15F),
+
+        // butt
+        // remove butt impressions
+        Derived("ButtDimples", 0.0F),
+        Derived("ButtUnderFold", 0.0F),
+        // shrink ass slightly
+        Fixed("AppleCheeks", -0.05F),
+        Fixed("Butt", -0.05F),
+
+        // Torso
+        // remove definition on clavical bone
+        Derived("Clavicle_v2", 0.0F),
+        // Push out navel
+        Derived("NavelEven", 1.0F),
+
+        // hip
+        // remove defintion on hip bone
+        Derived("HipCarved", 0.0F),
+
+        // nipple
+        // sublte change to tip shape
+        Derived("NippleDip", 0.0F, true),
+        Derived("NippleTip", 0.0F, true),
+        // flatten areola
+        Derived("NipplePuffy_v2", 0.0F, true),
+        // shrink areola
+        Derived("AreolaSize", -0.3F, true),
+        // flatten nipple
+        Derived("NipBGone", 1.0F, true),
+        // Derived("NippleManga", -0.75f, true),
+        //  push nipples together
+        Fixed("NippleDistance", 0.05F, 0.08F, true),
+        // Lift large breasts up
+        Fixed("NippleDown", 0.0F, -0.1F, true),
+        // Flatten nipple + areola
+        Derived("NipplePerkManga", -0.25F, true),
+        // Flatten nipple
+        // Derived("NipplePerkiness", 0.0f, true),
+    };
+
+    inline constexpr std::size_t DerivedSliderCount{static_cast<std::size_t>(
+        std::ranges::count_if(Sliders, [](const SliderDefinition& a_slider) { return a_slider.derived; }))};
+
+    // The values of the derived sliders for an actor, in the order they appear in `Sliders`.
+    // These only depend on the actor's OBody morphs, so we work them out when the actor's body is generated,
+    // and equipping or unequipping armor then needs neither to read morphs back from RaceMenu nor to allocate.
+    struct Baseline {
+        std::array<float, DerivedSliderCount> derivedValues{};
+    };
+}  // namespace Body::ORefit
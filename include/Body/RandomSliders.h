@@ -0,0 +1,239 @@
+#pragma once
+
+#include "STL.h"
+
+namespace Body::RandomSliders {
+    // The random nipple and genital sliders are described by small programs, a rule at a time:
+    // a slider is either set to a fixed value or rolled within a range,
+    // and `If` rules roll a chance to decide whether what follows them, up to their `Else` or `End`, is run.
+    // The rolled values don't depend on the actor's weight, so they're applied as they are.
+    struct Rule {
+        enum class Op : uint8_t { kSet, kIf, kElse, kEnd };
+
+        Op op;
+        const char* name = nullptr;
+        float min = 0.0F;
+        float max = 0.0F;
+        // A percentage, as `stl::chance` takes it.
+        int chance = 0;
+    };
+
+    consteval Rule Fixed(const char* a_name, const float a_value) {
+        return {Rule::Op::kSet, a_name, a_value, a_value};
+    }
+
+    // Rolled within [min, max).
+    consteval Rule Random(const char* a_name, const float a_min, const float a_max) {
+        return {Rule::Op::kSet, a_name, a_min, a_max};
+    }
+
+    consteval Rule If(const int a_chance) { return {Rule::Op::kIf, nullptr, 0.0F, 0.0F, a_chance}; }
+
+    inline constexpr Rule Else{Rule::Op::kElse};
+    inline constexpr Rule End{Rule::Op::kEnd};
+
+    // Checks that every `If` has its `End`, with at most one `Else` in between, and that every range is a range.
+    consteval bool IsWellFormed(const std::span<const Rule> a_rules) {
+        // Whether each open `If` has had its `Else` yet.
+        std::vector<bool> openBranches;
+
+        for (const auto& rule : a_rules) {
+            switch (rule.op) {
+                case Rule::Op::kSet:
+                    if (!rule.name || rule.min > rule.max) return false;
+                    break;
+                case Rule::Op::kIf:
+                    openBranches.push_back(false);
+                    break;
+                case Rule::Op::kElse:
+                    if (openBranches.empty() || openBranches.back()) return false;
+                    openBranches.back() = true;
+                    break;
+                case Rule::Op::kEnd:
+                    if (openBranches.empty()) return false;
+                    openBranches.pop_back();
+                    break;
+            }
+        }
+
+        return openBranches.empty();
+    }
+
+    // Returns the index of the rule which ends the branch that the rule at the given index begins:
+    // the matching `Else` or `End` for an `If`, and the matching `End` for an `Else`.
+    constexpr std::size_t FindEndOfBranch(const std::span<const Rule> a_rules, const std::size_t a_begin) {
+        const bool stopAtElse{a_rules[a_begin].op == Rule::Op::kIf};
+        std::size_t depth{0};
+
+        for (std::size_t i = a_begin + 1; i < a_rules.size(); ++i) {
+            switch (a_rules[i].op) {
+                case Rule::Op::kIf:
+                    ++depth;
+                    break;
+                case Rule::Op::kElse:
+                    if (depth == 0 && stopAtElse) return i;
+                    break;
+                case Rule::Op::kEnd:
+                    if (depth == 0) return i;
+                    --depth;
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        return a_rules.size();
+    }
+
+    // Runs the rules, handing each slider they set to a_setMorph along with its value.
+    template <typename SetMorph>
+    void Roll(const std::span<const Rule> a_rules, SetMorph&& a_setMorph) {
+        for (std::size_t i = 0; i < a_rules.size(); ++i) {
+            const auto& rule{a_rules[i]};
+
+            switch (rule.op) {
+                case Rule::Op::kSet:
+                    a_setMorph(rule.name, rule.min == rule.max ? rule.min : stl::random(rule.min, rule.max));
+                    break;
+                case Rule::Op::kIf:
+                    // Carry on past the `Else`, or the `End`, on a failed roll.
+                    if (!stl::chance(rule.chance)) i = FindEndOfBranch(a_rules, i);
+                    break;
+                case Rule::Op::kElse:
+                    // We only ever get here after running the `If` half of the branch.
+                    i = FindEndOfBranch(a_rules, i);
+                    break;
+                case Rule::Op::kEnd:
+                    break;
+            }
+        }
+    }
+
+    // clang-format off
+    inline constexpr std::array Nipple{
+        If(15),
+            Random("AreolaSize", -1.0F, 0.0F),
+        Else,
+            Random("AreolaSize", 0.0F, 1.0F),
+        End,
+
+        If(75), Random("AreolaPull_v2", -0.25F, 1.0F), End,
+
+        If(15),
+            Random("NippleLength", 0.2F, 0.3F),
+        Else,
+            Random("NippleLength", 0.0F, 0.1F),
+        End,
+
+        Random("NippleManga", -0.3F, 0.8F),
+
+        If(25), Random("NipplePerkManga", -0.3F, 1.2F), End,
+
+        If(15), Random("NipBGone", 0.6F, 1.0F), End,
+
+        Random("NippleSize", -0.5F, 0.3F),
+        Random("NippleDip", 0.0F, 1.0F),
+        Random("NippleCrease_v2", -0.4F, 1.0F),
+
+        If(6), Random("NipplePuffy_v2", 0.4F, 0.7F), End,
+
+        If(35), Random("NippleThicc_v2", 0.0F, 0.9F), End,
+
+        If(2),
+            If(50),
+                Fixed("NippleInvert_v2", 1.0F),
+            Else,
+                Random("NippleInvert_v2", 0.65F, 0.8F),
+            End,
+        End,
+    };
+
+    inline constexpr std::array Genital{
+        If(20),
+            // innie
+            Random("Innieoutie", 0.95F, 1.1F),
+
+            If(50), Random("Labiapuffyness", 0.75F, 1.25F), End,
+
+            If(40), Random("LabiaMorePuffyness_v2", 0.0F, 1.0F), End,
+
+            Random("Labiaprotrude", 0.0F, 0.5F),
+            Random("Labiaprotrude2", 0.0F, 0.1F),
+            Random("Labiaprotrudeback", 0.0F, 0.1F),
+            Fixed("Labiaspread", 0.0F),
+            Random("LabiaCrumpled_v2", 0.0F, 0.3F),
+            Fixed("LabiaBulgogi_v2", 0.0F),
+            Fixed("LabiaNeat_v2", 0.0F),
+            Random("VaginaHole", -0.2F, 0.05F),
+            Random("Clit", -0.4F, 0.25F),
+        Else,
+            If(75),
+                // average
+                Random("Innieoutie", 0.4F, 0.75F),
+
+                If(40), Random("Labiapuffyness", 0.5F, 1.0F), End,
+
+                If(30), Random("LabiaMorePuffyness_v2", 0.0F, 0.75F), End,
+
+                Random("Labiaprotrude", 0.0F, 0.5F),
+                Random("Labiaprotrude2", 0.0F, 0.75F),
+                Random("Labiaprotrudeback", 0.0F, 1.0F),
+
+                If(50),
+                    Random("Labiaspread", 0.0F, 1.0F),
+                    Random("LabiaCrumpled_v2", 0.0F, 0.7F),
+
+                    If(60), Random("LabiaBulgogi_v2", 0.0F, 0.1F), End,
+                Else,
+                    Fixed("Labiaspread", 0.0F),
+                    Random("LabiaCrumpled_v2", 0.0F, 0.2F),
+
+                    If(45), Random("LabiaBulgogi_v2", 0.0F, 0.3F), End,
+                End,
+
+                Fixed("LabiaNeat_v2", 0.0F),
+                Random("VaginaHole", -0.2F, 0.40F),
+                Random("Clit", -0.2F, 0.25F),
+            Else,
+                // outie
+                Random("Innieoutie", -0.25F, 0.30F),
+
+                If(30), Random("Labiapuffyness", 0.20F, 0.50F), End,
+
+                If(10), Random("LabiaMorePuffyness_v2", 0.0F, 0.35F), End,
+
+                Random("Labiaprotrude", 0.0F, 1.0F),
+                Random("Labiaprotrude2", 0.0F, 1.0F),
+                Random("Labiaprotrudeback", 0.0F, 1.0F),
+                Random("Labiaspread", 0.0F, 1.0F),
+                Random("LabiaCrumpled_v2", 0.0F, 1.0F),
+                Random("LabiaBulgogi_v2", 0.0F, 1.0F),
+
+                If(40), Random("LabiaNeat_v2", 0.0F, 0.25F), End,
+
+                Random("VaginaHole", 0.0F, 1.0F),
+                Random("Clit", -0.4F, 0.25F),
+            End,
+        End,
+
+        Random("Vaginasize", 0.0F, 1.0F),
+        Random("ClitSwell_v2", -0.3F, 1.1F),
+        Random("Cutepuffyness", 0.0F, 1.0F),
+        Random("LabiaTightUp", 0.0F, 1.0F),
+
+        If(60),
+            Random("CBPC", -0.25F, 0.25F),
+        Else,
+            Random("CBPC", 0.6F, 1.0F),
+        End,
+
+        Random("AnalPosition_v2", 0.0F, 1.0F),
+        Random("AnalTexPos_v2", 0.0F, 1.0F),
+        Random("AnalTexPosRe_v2", 0.0F, 1.0F),
+        Fixed("AnalLoose_v2", -0.1F),
+    };
+    // clang-format on
+
+    static_assert(IsWellFormed(Nipple));
+    static_assert(IsWellFormed(Genital));
+}  // namespace Body::RandomSliders
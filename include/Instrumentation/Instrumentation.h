@@ -0,0 +1,91 @@
+#pragma once
+
+// Some light instrumentation of the work that OBody does while the game runs, so that we can tell where its
+// frame time goes. Each stage keeps a count of how often it ran, how long it took, and a histogram of its
+// durations, all in relaxed atomics, so timing a stage costs a couple of clock reads and a few uncontended adds.
+//
+// The per-actor log lines are logged from those same paths, and formatting them costs more than timing them,
+// so they go through OBODY_ACTOR_LOG, which builds with OBODY_ACTOR_LOGGING set to 0 compile out,
+// and which `actorLogging` turns off at runtime.
+
+#ifndef OBODY_ACTOR_LOGGING
+    #define OBODY_ACTOR_LOGGING 1
+#endif
+
+namespace Instrumentation {
+    inline std::atomic<bool> actorLogging{true};
+    // While set, the runs of the current thread go unrecorded, so that the benchmarks can time the stages
+    // without their runs being counted among those of the game.
+    inline thread_local bool recordingPaused{false};
+
+#if OBODY_ACTOR_LOGGING
+    #define OBODY_ACTOR_LOG(...) \
+        do { \
+            if (::Instrumentation::actorLogging.load(std::memory_order_relaxed)) logger::info(__VA_ARGS__); \
+        } while (false)
+#else
+    #define OBODY_ACTOR_LOG(...) \
+        do { \
+        } while (false)
+#endif
+
+    enum class Stage : uint8_t {
+        // Deciding which presets an actor's distribution rules give them.
+        DistributionDecision,
+        // Working out the morphs of an actor's preset, random sliders and ORefit.
+        SliderBuild,
+        // Handing the morphs to RaceMenu, and having it apply them.
+        SKEECalls,
+        // Sending the events of the plugin-API to its listeners.
+        EventDispatch,
+        // Telling whether an actor's armor is blacklisted from, or forces, ORefit.
+        EquipClassification,
+        CosaveRead,
+        CosaveWrite,
+        Count
+    };
+
+    inline constexpr std::size_t StageCount{static_cast<std::size_t>(Stage::Count)};
+
+    // Bucket i counts the runs that took less than 2^i microseconds, bar the last, which counts all the rest.
+    inline constexpr std::size_t HistogramBucketCount = 16;
+
+    struct StageTimings {
+        uint64_t count = 0;
+        uint64_t totalNanoseconds = 0;
+        uint64_t maxNanoseconds = 0;
+        std::array<uint64_t, HistogramBucketCount> histogram{};
+    };
+
+    const char* GetStageName(Stage a_stage);
+
+    void Record(Stage a_stage, std::chrono::nanoseconds a_duration);
+    [[nodiscard]] StageTimings GetTimings(Stage a_stage);
+    void Reset();
+
+    // Logs the timings of every stage that has run.
+    void Dump(spdlog::level::level_enum a_level = spdlog::level::info);
+
+    // Times the scope it's declared in as a run of the given stage.
+    class ScopedTimer {
+    public:
+        explicit ScopedTimer(const Stage a_stage) : stage(a_stage) {}
+        ~ScopedTimer() { Stop(); }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+        // Ends the run there and then, rather than at the end of the scope.
+        void Stop() {
+            if (stopped) return;
+
+            Record(stage, std::chrono::steady_clock::now() - start);
+            stopped = true;
+        }
+
+    private:
+        Stage stage;
+        bool stopped = false;
+        std::chrono::steady_clock::time_point start{std::chrono::steady_clock::now()};
+    };
+}  // namespace Instrumentation
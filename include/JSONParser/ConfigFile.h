@@ -0,0 +1,17 @@
+#pragma once
+
+// Reading, parsing and validating the preset distribution config, both when the plugin is loaded
+// and whenever the config is reloaded in-game.
+namespace ConfigFile {
+    inline constexpr auto ConfigPath{"Data/SKSE/Plugins/OBody_presetDistributionConfig.json"};
+    inline constexpr auto SchemaPath{"Data/SKSE/Plugins/OBody_presetDistributionConfig_schema.json"};
+
+    std::optional<std::string> Read(const char* a_path);
+
+    // The files may be in any UTF encoding, with or without a byte-order mark.
+    rapidjson::Document& Parse(rapidjson::Document& a_document, std::string_view a_json);
+
+    // Validates the config against the schema, logging where it fails to.
+    // Returns false should the config be invalid, or the schema fail to parse.
+    bool Validate(const rapidjson::Document& a_config, std::string_view a_schemaJson);
+}  // namespace ConfigFile
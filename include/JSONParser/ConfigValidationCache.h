@@ -0,0 +1,27 @@
+#pragma once
+
+// Validating the distribution config against its schema takes a noticeable part of the plugin's load time
+// for the larger configs, and the config hardly ever changes between launches. So we remember the fingerprint
+// of the last config, and schema, that passed validation, and skip validating them again while it matches.
+//
+// Only the successful validations are remembered: an invalid config is validated, and reported, on every launch.
+namespace ConfigValidationCache {
+    constexpr uint32_t Magic = 0x4356424f;  // "OBVC"
+    constexpr uint32_t FormatVersion = 1;
+
+    inline constexpr auto CachePath{R"(Data\SKSE\Plugins\OBody_configValidationCache.bin)"};
+
+    struct HeaderV1 {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t fingerprint;
+    };
+
+    static_assert(sizeof(HeaderV1) == 16);
+
+    uint64_t ComputeFingerprint(std::string_view a_config, std::string_view a_schema);
+
+    // Whether the last config that passed validation has the given fingerprint.
+    bool IsValidated(uint64_t a_fingerprint);
+    void SaveValidated(uint64_t a_fingerprint);
+}  // namespace ConfigValidationCache
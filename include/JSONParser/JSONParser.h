@@ -1,6 +1,10 @@
 #pragma once
 
 #include "../PresetManager/PresetManager.h"
+#include "STL.h"
+
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <boost/unordered/unordered_flat_set.hpp>
 
 namespace Parser {
     struct categorizedList {
@@ -9,6 +13,75 @@ namespace Parser {
         std::vector<std::string> bodyslidePresets;
     };
 
+    // The preset distribution config, compiled into hashtables once the presets have been generated,
+    // so that deciding which preset an actor gets never has to walk the rapidjson document.
+    // Names are matched case-insensitively, races and factions are matched by their form-ID,
+    // and preset names are resolved to the presets proper ahead of time.
+    struct CompiledRules {
+        using PresetList = std::vector<const PresetManager::Preset*>;
+        using NameSet = boost::unordered_flat_set<std::string, stl::ihash, stl::iequal_to>;
+        template <typename Value>
+        using NameMap = boost::unordered_flat_map<std::string, Value, stl::ihash, stl::iequal_to>;
+
+        // Factions and plugins are checked in the order they're written in the config,
+        // the first one that matches being the one whose presets are used.
+        // We keep that order around as a rank, so the lowest ranked match wins.
+        struct RankedPresetList {
+            uint32_t rank = 0;
+            PresetList presets;
+        };
+
+        // The presets are resolved differently for each sex, so each sex gets its own rules.
+        struct SexSpecificRules {
+            boost::unordered_flat_map<RE::FormID, PresetList> presetsByNPCFormID;
+            NameMap<PresetList> presetsByNPCName;
+            boost::unordered_flat_map<RE::FormID, RankedPresetList> presetsByFaction;
+            NameMap<RankedPresetList> presetsByPlugin;
+            boost::unordered_flat_map<RE::FormID, PresetList> presetsByRace;
+
+            NameSet blacklistedPlugins;
+            boost::unordered_flat_set<RE::FormID> blacklistedRaces;
+        };
+
+        NameSet blacklistedNPCNames;
+
+        NameSet blacklistedOutfitNames;
+        NameSet blacklistedOutfitPlugins;
+        NameSet forceRefitOutfitNames;
+
+        SexSpecificRules female;
+        SexSpecificRules male;
+    };
+
+    // What the distribution rules decide for an NPC base of a given sex.
+    // Bar the plugin blacklist, which looks at the plugin of each actor's reference rather than of their base,
+    // the rules depend on nothing but the base, so we only need to work this out once per base.
+    struct DistributionDecision {
+        enum class Outcome : uint8_t {
+            Blacklisted,
+            // The presets come from the npcFormID or npc keys, which take precedence over the plugin blacklist.
+            NPCPresets,
+            // The presets come from the faction, plugin or race keys, or from the random pool if none of those apply.
+            DistributedPresets
+        };
+
+        Outcome outcome = Outcome::DistributedPresets;
+        // Null when the preset is to be picked from the random pool.
+        const CompiledRules::PresetList* presets = nullptr;
+    };
+
+    // How ORefit treats an armor. This depends on nothing but the armor and the config,
+    // so we only need to work it out once per armor.
+    struct OutfitClassification {
+        // Blacklisted from ORefit by name, form-ID or plugin.
+        bool blacklisted = false;
+        // Forces ORefit by name or form-ID.
+        bool forcesRefit = false;
+    };
+
+    // Returns null for an empty list.
+    const PresetManager::Preset* GetRandomPresetFromList(const CompiledRules::PresetList& a_presets);
+
     class JSONParser {
     public:
         JSONParser(JSONParser&&) = delete;
@@ -26,36 +99,52 @@ namespace Parser {
         void FilterOutNonLoaded();
 
         void ProcessJSONCategories();
+        void CompileRules();
 
         [[nodiscard]] bool IsActorInBlacklistedCharacterCategorySet(uint32_t formID) const;
-        bool IsOutfitInBlacklistedOutfitCategorySet(uint32_t formID);
+        [[nodiscard]] bool IsOutfitInBlacklistedOutfitCategorySet(uint32_t formID) const;
         [[nodiscard]] bool IsOutfitInForceRefitCategorySet(uint32_t formID) const;
 
-        [[nodiscard]] std::optional<categorizedList> GetNPCFromCategorySet(uint32_t formID) const;
-        bool IsStringInJsonConfigKey(std::string_view a_value, const char* key);
-        bool IsSubKeyInJsonConfigKey(const char* key, std::string_view subKey);
+        // Returns null if the NPC isn't in the set.
+        [[nodiscard]] const categorizedList* GetNPCFromCategorySet(uint32_t formID) const;
 
+        // Memoized per armor, until the rules are next compiled.
+        OutfitClassification ClassifyOutfit(const RE::TESObjectARMO& a_outfit);
         bool IsOutfitBlacklisted(const RE::TESObjectARMO& a_outfit);
         bool IsAnyForceRefitItemEquipped(RE::Actor* a_actor, bool a_removingArmor, const RE::TESForm* a_equippedArmor);
-        bool IsNPCBlacklisted(std::string_view actorName, uint32_t actorID);
-        bool IsNPCBlacklistedGlobally(const RE::Actor* a_actor, const char* actorRace, bool female);
+        bool IsNPCBlacklisted(std::string_view actorName, uint32_t actorID) const;
+        bool IsNPCPluginBlacklisted(const RE::Actor* a_actor, bool female) const;
+        bool IsNPCRaceBlacklisted(const RE::TESRace* actorRace, bool female) const;
+
+        // These return null when no presets are defined for the actor.
+        const CompiledRules::PresetList* GetNPCFactionPresets(const RE::TESNPC* a_actor, bool female) const;
 
-        std::optional<PresetManager::Preset> GetNPCFactionPreset(const RE::TESNPC* a_actor, bool female);
+        const CompiledRules::PresetList* GetNPCPresets(const char* actorName, uint32_t formID, bool female) const;
+        const CompiledRules::PresetList* GetNPCPluginPresets(const RE::TESNPC* a_actor, const char* actorName,
+                                                             bool female) const;
+        const CompiledRules::PresetList* GetNPCRacePresets(const RE::TESRace* actorRace, bool female) const;
 
-        std::optional<PresetManager::Preset> GetNPCPreset(const char* actorName, uint32_t formID, bool female);
-        std::optional<PresetManager::Preset> GetNPCPluginPreset(const RE::TESNPC* a_actor, const char* actorName,
-                                                                bool female);
-        std::optional<PresetManager::Preset> GetNPCRacePreset(const char* actorRace, bool female);
+        // Memoized per NPC base and sex, until the rules are next compiled.
+        DistributionDecision GetDistributionDecision(const RE::TESNPC* a_actorBase, bool female);
 
         rapidjson::Document presetDistributionConfig;
+        // The fingerprint of the config and schema files that presetDistributionConfig was parsed from.
+        uint64_t presetDistributionConfigFingerprint = 0;
+        CompiledRules compiledRules;
+        // Keyed by the NPC base's form-ID shifted left by one, or'd with whether the decision is for a female.
+        boost::concurrent_flat_map<uint64_t, DistributionDecision> distributionDecisionForNPC;
+        boost::concurrent_flat_map<RE::FormID, OutfitClassification> outfitClassificationForArmor;
         bool bodyslidePresetsParsingValid{};
         std::size_t invalid_presets{};
 
-        std::vector<categorizedList> blacklistedCharacterCategorySet;
-        std::vector<categorizedList> characterCategorySet;
+        // These are checked for every actor we generate and every equip event we process,
+        // and modlists can list a great many forms in them, so they're keyed by form-ID.
+        boost::unordered_flat_set<RE::FormID> blacklistedCharacterCategorySet;
+        // Should a form be listed more than once, the first listing is the one that's kept.
+        boost::unordered_flat_map<RE::FormID, categorizedList> characterCategorySet;
 
-        std::vector<categorizedList> blacklistedOutfitCategorySet;
-        std::vector<categorizedList> forceRefitOutfitCategorySet;
+        boost::unordered_flat_set<RE::FormID> blacklistedOutfitCategorySet;
+        boost::unordered_flat_set<RE::FormID> forceRefitOutfitCategorySet;
 
     private:
         JSONParser() = default;
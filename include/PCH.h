@@ -7,6 +7,13 @@
 #include <unordered_set>
 #include <ranges>
 #include <filesystem>
+#include <deque>
+#include <shared_mutex>
+#include <condition_variable>
+#include <bit>
+#include <execution>
+#include <functional>
+#include <variant>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/msvc_sink.h>
 
@@ -18,6 +25,7 @@
 #include <rapidjson/prettywriter.h>
 #include <rapidjson/error/en.h>
 #include <rapidjson/filereadstream.h>
+#include <rapidjson/memorystream.h>
 #include <rapidjson/schema.h>
 #include <pugixml.hpp>
 #include <random>
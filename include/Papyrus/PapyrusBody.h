@@ -15,6 +15,26 @@ namespace PapyrusBody {
 
     void SetPerformanceMode(RE::StaticFunctionTag*, bool a_enabled);
 
+    void SetMorphUpdatesPerFrame(RE::StaticFunctionTag*, int a_count);
+
+    void SetDeferredGeneration(RE::StaticFunctionTag*, bool a_enabled);
+
+    void SetDeferredGenerationBudget(RE::StaticFunctionTag*, int a_microseconds);
+
+    // A seed of zero, the default, makes the random sliders and presets random again.
+    void SetRandomSeed(RE::StaticFunctionTag*, int a_seed);
+
+    // Whether the lines logged for each actor that OBody processes are written to OBody.log.
+    void SetActorLogging(RE::StaticFunctionTag*, bool a_enabled);
+
+    // Writes how long each stage of OBody's work has taken to OBody.log.
+    void DumpStageTimings(RE::StaticFunctionTag*);
+
+    void ResetStageTimings(RE::StaticFunctionTag*);
+
+    // Benchmarks the distribution, equip classification and cosave paths, writing the results to OBody.log.
+    void RunBenchmarks(RE::StaticFunctionTag*, int a_iterations);
+
     void SetRespectfulMorphApplication(RE::StaticFunctionTag*, bool a_enabled);
 
     void SetLegacyStorageUtilUsageEnabled(RE::StaticFunctionTag*, bool a_enabled);
@@ -39,6 +59,15 @@ namespace PapyrusBody {
 
     void ReapplyActorOBodyMorphs(RE::StaticFunctionTag*, RE::Actor* a_actor);
 
+    // Regenerates every loaded NPC over the following frames, and then sends the "OBody_LoadedActorsRegenerated"
+    // mod event. With a_keepAssignedPresets, actors keep their presets, as with ReapplyActorOBodyMorphs.
+    void RegenerateLoadedActors(RE::StaticFunctionTag*, bool a_keepAssignedPresets);
+
+    // Reloads the preset distribution config and the presets, should they have changed, regenerating the loaded NPCs
+    // that the changed rules no longer fit, and then sends the "OBody_ConfigReloaded" mod event.
+    // Returns whether the reload was started.
+    bool ReloadConfig(RE::StaticFunctionTag*);
+
     std::vector<std::string> GetAllPossiblePresets(RE::StaticFunctionTag*, RE::Actor* a_actor);
 
     std::string GetPresetAssignedToActor(RE::StaticFunctionTag*, RE::Actor* a_actor);
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "PresetManager/PresetManager.h"
+
+// Parsing every BodySlide preset XML on every launch is wasted work when none of them have changed,
+// which is the case for almost every launch. So we keep the output of GeneratePresets on disk,
+// alongside a fingerprint of what it was generated from, and reuse it while the fingerprint still matches.
+//
+// The cache is a flat, offset-based file: a header, then fixed-size records for the presets and their sliders,
+// then a single table holding all the strings, so reading it is one read and a walk over those records.
+// Any change to the preset files (their names, sizes or modification times), to the preset blacklist,
+// or to how we parse presets (which requires bumping FormatVersion) invalidates the cache.
+namespace PresetCache {
+    constexpr uint32_t Magic = 0x4350424f;  // "OBPC"
+    constexpr uint32_t FormatVersion = 1;
+
+    inline constexpr auto CachePath{R"(Data\SKSE\Plugins\OBody_presetCache.bin)"};
+
+    struct HeaderV1 {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t fingerprint;
+        uint32_t invalidPresetFiles;
+        // Female, male, blacklisted female, blacklisted male; the records are stored in that order.
+        uint32_t presetCounts[4];
+        uint32_t sliderCount;
+        uint32_t stringTableSize;
+        uint32_t reserved;
+    };
+
+    static_assert(sizeof(HeaderV1) == 48);
+
+    struct PresetRecordV1 {
+        uint32_t nameOffset;
+        uint32_t nameLength;
+        uint32_t bodyOffset;
+        uint32_t bodyLength;
+        uint32_t firstSlider;
+        uint32_t sliderCount;
+    };
+
+    static_assert(sizeof(PresetRecordV1) == 24);
+
+    // The sliders are stored with the UNP inversion already applied.
+    struct SliderRecordV1 {
+        uint32_t nameOffset;
+        uint32_t nameLength;
+        float min;
+        float max;
+    };
+
+    static_assert(sizeof(SliderRecordV1) == 16);
+
+    uint64_t ComputeFingerprint(const std::vector<fs::path>& a_presetFiles,
+                                const rapidjson::Value& a_blacklistedPresets);
+
+    // Fills the female, male and blacklisted preset sets from the cache.
+    // Returns false, leaving the sets untouched, if there's no usable cache for the given fingerprint.
+    bool Load(uint64_t a_fingerprint, PresetManager::PresetSets& a_presets, std::size_t& a_invalidPresetFiles);
+    void Save(uint64_t a_fingerprint, const PresetManager::PresetSets& a_presets, std::size_t a_invalidPresetFiles);
+}  // namespace PresetCache
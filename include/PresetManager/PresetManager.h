@@ -1,5 +1,7 @@
 #pragma once
 
+#include "STL.h"
+
 #include <boost/unordered/unordered_flat_map.hpp>
 
 namespace PresetManager {
@@ -29,6 +31,63 @@ namespace PresetManager {
 
     using SliderSet = boost::unordered_flat_map<std::string, Slider>;
 
+    // Almost every preset uses the same few hundred slider names, so rather than having every preset
+    // keep its own copy of each name, we keep a single copy of each in here and have presets refer to them by ID.
+    // Interning happens while presets are being generated, possibly from several threads at once.
+    using SliderNameID = uint32_t;
+
+    class SliderNameTable {
+    public:
+        SliderNameTable(SliderNameTable&&) = delete;
+        SliderNameTable(const SliderNameTable&) = delete;
+
+        SliderNameTable& operator=(SliderNameTable&&) = delete;
+        SliderNameTable& operator=(const SliderNameTable&) = delete;
+
+        static SliderNameTable& GetInstance();
+
+        SliderNameID Intern(std::string_view a_name);
+
+        // The returned names are null-terminated, and live for as long as the table does.
+        [[nodiscard]] const char* GetName(SliderNameID a_id) const;
+        // Resolves the names of the given IDs into the given buffer, locking the table only the once.
+        // As the names outlive the lock, this is for when they're to be handed to code that we'd rather not call
+        // while holding it, such as RaceMenu's.
+        void GetNames(std::span<const SliderNameID> a_ids, std::vector<const char*>& a_names) const;
+
+        // Calls the given function with the name of each of the given IDs, locking the table only the once.
+        template <typename Function>
+        void ForEachName(const std::span<const SliderNameID> a_ids, Function&& function) const {
+            std::shared_lock sharedLock{lock};
+            for (const auto id : a_ids) function(names[id].c_str());
+        }
+
+    private:
+        static SliderNameTable instance;
+
+        SliderNameTable() = default;
+
+        mutable std::shared_mutex lock;
+        // A deque, as it never moves its elements, so the keys below can view them.
+        std::deque<std::string> names;
+        boost::unordered_flat_map<std::string_view, SliderNameID> idsByName;
+    };
+
+    // A preset's sliders, stored as parallel arrays of their name IDs, minimums and maximums,
+    // so that interpolating them for an actor's weight is a straight walk over contiguous floats.
+    struct PresetSliders {
+        std::vector<SliderNameID> nameIDs;
+        std::vector<float> mins;
+        std::vector<float> maxes;
+
+        [[nodiscard]] std::size_t size() const { return nameIDs.size(); }
+
+        void reserve(std::size_t a_count);
+        void push_back(SliderNameID a_nameID, float a_min, float a_max);
+
+        static PresetSliders FromSliderSet(const SliderSet& a_sliderSet);
+    };
+
     struct Preset;
 
     // We can refer to presets by their index rather than their name.
@@ -72,19 +131,34 @@ namespace PresetManager {
     struct Preset {
         Preset() = default;
         explicit Preset(const char* a_name) : name(a_name) {}
-        Preset(const char* a_name, const char* a_body, SliderSet&& a_sliders)
+        Preset(const char* a_name, const char* a_body, PresetSliders&& a_sliders)
             : name(a_name), body(a_body), sliders(std::move(a_sliders)) {}
-        ~Preset() = default;
 
         std::string name;
         std::string body;
-        SliderSet sliders;
+        PresetSliders sliders;
         AssignedPresetIndex assignedIndex;
     };
 
     using PresetSet = std::vector<Preset>;
     using SparsePresetMapping = std::vector<SparsePresetIndex>;
 
+    // The presets as they're read from the BodySlide files, or from the preset cache,
+    // before they take the place of the preset-container's presets.
+    struct PresetSets {
+        PresetSet femalePresets;
+        PresetSet malePresets;
+        PresetSet blacklistedFemalePresets;
+        PresetSet blacklistedMalePresets;
+    };
+
+    // The SliderPresets files, along with a fingerprint of them and the preset blacklist,
+    // which tells whether they've changed since the presets were loaded from them.
+    struct PresetFiles {
+        std::vector<fs::path> paths;
+        uint64_t fingerprint = 0;
+    };
+
     class PresetContainer {
     public:
         PresetContainer(PresetContainer&&) = delete;
@@ -117,8 +191,34 @@ namespace PresetManager {
         boost::unordered_flat_map<std::string, AssignedPresetIndex> malePresetIndexByName;
         AssignedPresetIndex nextFemalePresetIndex;
         AssignedPresetIndex nextMalePresetIndex;
+        /* These are for general lookups: they map a preset's name, case-insensitively,
+           to its dense index in `allFemalePresets`/`allMalePresets`.
+           The keys view the names of the presets proper, so these must be rebuilt whenever those sets change. */
+        boost::unordered_flat_map<std::string_view, uint32_t, stl::ihash, stl::iequal_to> allFemalePresetsByName;
+        boost::unordered_flat_map<std::string_view, uint32_t, stl::ihash, stl::iequal_to> allMalePresetsByName;
+        /* These view the names of the presets, sorted case-insensitively, in the order that the OBody menu lists them,
+           so that opening the menu needn't sort them again. Like the lookups by name, they view the names of the
+           presets proper, so these must be rebuilt whenever those sets change. */
+        std::vector<std::string_view> sortedFemalePresetNames;
+        std::vector<std::string_view> sortedMalePresetNames;
+        std::vector<std::string_view> sortedAllFemalePresetNames;
+        std::vector<std::string_view> sortedAllMalePresetNames;
+
+        // The fingerprint of the preset files that the presets were loaded from.
+        uint64_t presetFilesFingerprint = 0;
+        // Counts the times the presets were replaced, so that whoever holds on to pointers into them
+        // past the current frame can tell whether they're still good.
+        std::atomic<uint32_t> revision{0};
+
+        // Takes the place of the presets that were loaded before, rebuilding everything that views them.
+        // The preset indexes are kept, but the new presets need AssignPresetIndexes to be given theirs.
+        void ReplacePresets(PresetSets&& a_presets, uint64_t a_fingerprint);
 
         void AssignPresetIndexes();
+        void IndexPresetsByName();
+        void SortPresetNames();
+
+        [[nodiscard]] const Preset* FindPresetByName(std::string_view a_name, bool female) const;
 
         static PresetContainer& GetInstance();
 
@@ -132,13 +232,27 @@ namespace PresetManager {
     bool IsClothedSet(std::string_view a_set);
     bool IsClothedSet(std::wstring_view a_set);
 
-    Preset GetPresetByName(const PresetSet& a_presetSet, std::string_view a_name, bool female);
-    Preset GetRandomPreset(const PresetSet& a_presetSet);
-    std::optional<Preset> GetRandomPresetByName(const PresetSet& a_presetSet, std::vector<std::string_view> a_presetNames,
-                                 bool female);
+    // These return pointers into the preset-container's storage, rather than copies of the presets,
+    // as a preset and its sliders are far too large to be copying for every actor that we process.
+    // A null pointer signifies that no preset could be found.
+    // Lookups by name search both the blacklisted and non-blacklisted presets for the given sex.
+    const Preset* GetPresetByName(std::string_view a_name, bool female);
+    const Preset* GetRandomPreset(const PresetSet& a_presetSet);
 
-    std::optional<Preset> GetPresetByNameForRandom(const PresetSet& a_presetSet, std::string_view a_name);
+    const Preset* GetPresetByNameForRandom(std::string_view a_name, bool female);
 
+    PresetFiles ListPresetFiles(const rapidjson::Value& a_blacklistedPresets);
+    // This doesn't touch the preset-container, so it can be called from any thread.
+    PresetSets LoadPresets(const PresetFiles& a_files, const rapidjson::Value& a_blacklistedPresets,
+                           std::size_t& a_invalidPresetFiles);
+    // As LoadPresets, but always parses the preset files, neither reading nor writing the preset cache.
+    PresetSets ParsePresets(const PresetFiles& a_files, const rapidjson::Value& a_blacklistedPresets,
+                            std::size_t& a_invalidPresetFiles);
+    // Gives the presets of one sex their indexes, as PresetContainer::AssignPresetIndexes does for each sex,
+    // but into the given maps, so that it can be done on presets other than the preset-container's.
+    void AssignPresetIndexesForSex(PresetSet& a_allPresets, PresetSet& a_presets, PresetSet& a_blacklistedPresets,
+                                   boost::unordered_flat_map<std::string, AssignedPresetIndex>& a_presetIndexByName,
+                                   SparsePresetMapping& a_presetsByIndex, AssignedPresetIndex& a_nextPresetIndex);
     void GeneratePresets();
     std::optional<Preset> GeneratePreset(const pugi::xml_node& a_node);
 
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "API/PluginInterface.h"
+
+// Reloads the preset distribution config and the BodySlide presets mid-game, so that they can be tweaked
+// without restarting the game. Only what changed since it was last loaded is read again: the config when
+// its fingerprint differs, and the presets when the fingerprint of their files, or of the preset blacklist, does.
+//
+// The files are read, parsed and validated on a thread of their own. The results then take the place of the
+// ones in use in a single task on the main thread, where the rules are compiled, as they resolve forms and
+// presets through the preset-container and the game's data. The preset indexes are kept, so the presets
+// assigned to actors are still theirs afterwards, and only the loaded NPCs whose distribution changed
+// such that their body no longer fits it are regenerated.
+namespace Reload {
+    // Called on the main thread with whether the reload succeeded, and the number of actors regenerated.
+    using OnComplete = std::function<void(bool, std::size_t)>;
+
+    // Once the reload is done, the "OBody_ConfigReloaded" mod event is sent, with the number of actors
+    // regenerated, or -1 should the reload have failed, in which case what was in use before stays in use.
+    // Returns false, doing nothing, should OBody not be ready yet, or should a reload be under way already.
+    bool Request(::OBody::API::IPluginInterface* responsibleInterface, OnComplete a_onComplete = {});
+
+    // The reload replaces the rules and the presets on the main thread, so code running there always sees them whole,
+    // but the plugin-API may be called on any thread. Its methods that read the rules or the presets hold one of these
+    // for as long as they do, and the reload takes the lock they share exclusively while it replaces them.
+    // A thread that holds one already, such as that of an event-listener calling back into the plugin-API
+    // from within one of those methods, doesn't wait for the lock again.
+    class ReadGuard {
+    public:
+        ReadGuard();
+        ~ReadGuard();
+
+        ReadGuard(ReadGuard&&) = delete;
+        ReadGuard(const ReadGuard&) = delete;
+
+        ReadGuard& operator=(ReadGuard&&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+    };
+}  // namespace Reload
@@ -31,6 +31,115 @@ namespace stl {
         return boost::algorithm::iequals(a_str1, a_str2);
     }
 
+    // Case-insensitive hashing and equality, for hashtables keyed by names from the config.
+    // Both are transparent, so lookups can be made with a string_view without building a std::string.
+    struct iequal_to {
+        using is_transparent = void;
+
+        bool operator()(const std::string_view a_str1, const std::string_view a_str2) const {
+            return cmp(a_str1, a_str2);
+        }
+    };
+
+    // Case-insensitive ordering, for sorting names as the player would expect to see them listed.
+    struct iless {
+        bool operator()(const std::string_view a_str1, const std::string_view a_str2) const {
+            return boost::algorithm::ilexicographical_compare(a_str1, a_str2);
+        }
+    };
+
+    struct ihash {
+        using is_transparent = void;
+
+        std::size_t operator()(const std::string_view a_str) const noexcept {
+            // FNV-1a over the lower-cased characters.
+            std::uint64_t hash{0xcbf29ce484222325};
+            for (const char c : a_str) {
+                hash ^= static_cast<std::uint8_t>(std::tolower(static_cast<unsigned char>(c)));
+                hash *= 0x100000001b3;
+            }
+            return static_cast<std::size_t>(hash);
+        }
+    };
+
+    // xoshiro256**, seeded through splitmix64 as its authors recommend.
+    // Its whole state is four words, so unlike std::mt19937 it's as cheap to seed as it is to draw from.
+    class xoshiro256ss {
+    public:
+        using result_type = std::uint64_t;
+
+        explicit xoshiro256ss(const std::uint64_t a_seed) noexcept { seed(a_seed); }
+
+        void seed(std::uint64_t a_seed) noexcept {
+            for (auto& word : state) {
+                a_seed += 0x9e3779b97f4a7c15;
+                std::uint64_t z{a_seed};
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+                word = z ^ (z >> 31);
+            }
+        }
+
+        static constexpr result_type min() { return std::numeric_limits<result_type>::min(); }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        result_type operator()() noexcept {
+            const auto result{std::rotl(state[1] * 5, 7) * 9};
+            const auto t{state[1] << 17};
+
+            state[2] ^= state[0];
+            state[3] ^= state[1];
+            state[1] ^= state[2];
+            state[0] ^= state[3];
+            state[2] ^= t;
+            state[3] = std::rotl(state[3], 45);
+
+            return result;
+        }
+
+    private:
+        std::array<std::uint64_t, 4> state{};
+    };
+
+    namespace detail {
+        // Zero when the generators are to be seeded from std::random_device.
+        inline std::atomic<std::uint64_t> randomSeed{0};
+        // Bumped whenever the seed is changed, so that each thread reseeds its generator upon its next draw.
+        inline std::atomic<std::uint32_t> randomSeedGeneration{0};
+
+        inline xoshiro256ss& random_engine() {
+            struct ThreadEngine {
+                xoshiro256ss engine{0};
+                std::uint32_t generation{std::numeric_limits<std::uint32_t>::max()};
+            };
+
+            // Each thread gets its own generator, so that drawing from it needs no locking,
+            // and std::random_device, which is a call into the OS, is only used to seed it.
+            thread_local ThreadEngine threadEngine;
+
+            if (const auto generation{randomSeedGeneration.load(std::memory_order_acquire)};
+                generation != threadEngine.generation) [[unlikely]] {
+                auto seed{randomSeed.load(std::memory_order_relaxed)};
+                if (seed == 0) {
+                    std::random_device rd;
+                    seed = (static_cast<std::uint64_t>(rd()) << 32) | rd();
+                }
+
+                threadEngine.engine.seed(seed);
+                threadEngine.generation = generation;
+            }
+
+            return threadEngine.engine;
+        }
+    }  // namespace detail
+
+    // Makes `random` and `chance` deterministic, every thread drawing the same sequence from the given seed.
+    // This is meant for reproducing bodies while debugging; a seed of zero goes back to seeding them randomly.
+    inline void seed_random(const std::uint64_t a_seed) {
+        detail::randomSeed.store(a_seed, std::memory_order_relaxed);
+        detail::randomSeedGeneration.fetch_add(1, std::memory_order_release);
+    }
+
     // ReSharper disable once CppNotAllPathsReturnValue
     template <class T>
         requires std::is_integral_v<T> || std::is_floating_point_v<T>
@@ -49,8 +158,7 @@ namespace stl {
             }
             throw std::invalid_argument(errorMessage);
         }
-        std::random_device rd;
-        std::mt19937 gen(rd());
+        auto& gen{detail::random_engine()};
         if constexpr (std::is_integral_v<T>) {
             std::uniform_int_distribution<T> distrib(min, max - 1);
             return distrib(gen);
@@ -165,6 +273,25 @@ namespace stl {
         errno_t err{};
     };
 
+    // FNV-1a, fed a piece at a time. Used to fingerprint what our on-disk caches were made from.
+    struct Fingerprinter {
+        uint64_t hash{0xcbf29ce484222325};
+
+        void Add(const void* a_data, const std::size_t a_size) {
+            const auto* bytes{static_cast<const uint8_t*>(a_data)};
+            for (std::size_t i = 0; i < a_size; ++i) {
+                hash ^= bytes[i];
+                hash *= 0x100000001b3;
+            }
+        }
+
+        template <typename T>
+            requires std::is_trivially_copyable_v<T>
+        void Add(const T& a_value) {
+            Add(&a_value, sizeof(T));
+        }
+    };
+
     class timeit {
     public:
         explicit timeit(const std::source_location& a_curr = std::source_location::current()) : curr(a_curr) {}
@@ -20,8 +20,31 @@ namespace SaveFileState {
 
     bool WriteRecordDataForActorRegistryV0(SKSE::SerializationInterface* save, Buffer buffer,
                                            const ActorTracker::Registry& registry);
-    bool ReadRecordDataForActorRegistryV0(SKSE::SerializationInterface* load, Buffer buffer,
+    bool ReadRecordDataForActorRegistryV0(SKSE::SerializationInterface* load, Buffer buffer, uint32_t length,
                                           ActorTracker::Registry& registry);
+    // These take either SKSE's serialization interface or a `MemoryRecord`.
+    template <typename Serializer>
+    bool WriteRecordDataForActorRegistryV1(Serializer* save, Buffer buffer, const ActorTracker::Registry& registry);
+    template <typename Serializer>
+    bool ReadRecordDataForActorRegistryV1(Serializer* load, Buffer buffer, uint32_t length,
+                                          ActorTracker::Registry& registry);
+
+    // A stand-in for SKSE's serialization interface that holds a single record in memory,
+    // so that a record can be written and read back outside of saving and loading a game, such as for benchmarks.
+    // Form-IDs are resolved to themselves.
+    struct MemoryRecord {
+        std::vector<uint8_t> data;
+        size_t readOffset = 0;
+
+        bool WriteRecordData(const void* a_buffer, size_t a_length);
+        uint32_t ReadRecordData(void* a_buffer, size_t a_length);
+        bool ResolveFormID(RE::FormID a_oldFormID, RE::FormID& a_newFormID) const;
+    };
+
+    using LoadedActorStates = std::vector<std::pair<RE::FormID, ActorTracker::ActorState>>;
+
+    // Puts the actor-states read from a cosave into the registry all at once, the later of any duplicates winning.
+    void InsertLoadedActorStates(LoadedActorStates&& actorStates, ActorTracker::Registry& registry);
 
     bool WriteRecordDataForPresetNameIndexMapV0(SKSE::SerializationInterface* save, Buffer buffer,
                                                 const PresetManager::PresetContainer& presetContainer);
@@ -47,6 +70,16 @@ namespace SaveFileState {
 
     using PresetNameLength = uint32_t;
 
+    // The most bytes that a 32-bit integer takes up as a LEB128 varint.
+    constexpr size_t MaxVarintSize = 5;
+
+    // The smallest form-ID of the plugin that a form-ID belongs to, that is,
+    // the form-ID with everything but the plugin's index cleared. Light plugins share the 0xFE index,
+    // so theirs are told apart by the 12 bits that follow it.
+    constexpr RE::FormID GetPluginBaseOfFormID(const RE::FormID formID) {
+        return (formID >> 24) == 0xFE ? formID & 0xFFFFF000 : formID & 0xFF000000;
+    }
+
     // Used to round up an integer to a specified multiple-of-power-of-two alignment.
     template <typename I>
     inline __forceinline constexpr I AlignUpTo(I value, I alignment) {
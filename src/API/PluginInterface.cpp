@@ -1,5 +1,6 @@
 #include "API/PluginInterface.h"
 #include "Body/Body.h"
+#include "Reload/Reload.h"
 
 #pragma push_macro("max")
 #pragma push_macro("min")
@@ -7,20 +8,49 @@
 #undef min
 
 namespace OBody::API {
-    PluginInterface::PluginInterface(const char* owner, void* context) {
+    namespace {
+        const PresetManager::PresetSet* GetPresetsOfCategory(const PresetCategory category) {
+            const auto& presetContainer{PresetManager::PresetContainer::GetInstance()};
+            const PresetManager::PresetSet* presets;
+
+            switch (category) {
+                case PresetCategory::PresetCategoryFemale:
+                    presets = &presetContainer.femalePresets;
+                    break;
+                case PresetCategory::PresetCategoryFemaleBlacklisted:
+                    presets = &presetContainer.blacklistedFemalePresets;
+                    break;
+                case PresetCategory::PresetCategoryMale:
+                    presets = &presetContainer.malePresets;
+                    break;
+                case PresetCategory::PresetCategoryMaleBlacklisted:
+                    presets = &presetContainer.blacklistedMalePresets;
+                    break;
+                default:
+                    presets = nullptr;
+            }
+
+            return presets;
+        }
+    }  // namespace
+
+    PluginInterface::PluginInterface(const char* owner, void* context, const ::OBody::API::PluginAPIVersion version)
+        : version(version) {
         this->owner = owner;
         this->context = context;
     }
 
-    PluginAPIVersion PluginInterface::PluginAPIVersion() { return PluginAPIVersion::v1; }
+    PluginAPIVersion PluginInterface::PluginAPIVersion() { return version; }
 
     const char* PluginInterface::SetOwner(const char* a_owner) { return this->owner = a_owner; }
 
     bool PluginInterface::ActorIsNaked(RE::Actor* a_actor) {
+        Reload::ReadGuard const readGuard;
         return Body::OBody::GetInstance().IsNaked(a_actor, false, nullptr);
     }
 
     bool PluginInterface::ActorIsNaked(RE::Actor* a_actor, bool a_equippingArmor, const TESForm* a_equippedArmor) {
+        Reload::ReadGuard const readGuard;
         return Body::OBody::GetInstance().IsNaked(a_actor, !a_equippingArmor, a_equippedArmor);
     }
 
@@ -51,6 +81,8 @@ namespace OBody::API {
     }
 
     void PluginInterface::GetPresetCounts(PresetCounts& payload) {
+        Reload::ReadGuard const readGuard;
+
         const auto& presetContainer{PresetManager::PresetContainer::GetInstance()};
         payload.female = static_cast<decltype(payload.female)>(presetContainer.femalePresets.size());
         payload.male = static_cast<decltype(payload.male)>(presetContainer.malePresets.size());
@@ -62,25 +94,9 @@ namespace OBody::API {
 
     size_t PluginInterface::GetPresetNames(PresetCategory category, std::string_view* buffer, size_t bufferLength,
                                            size_t offset, size_t limit) {
-        const auto& presetContainer{PresetManager::PresetContainer::GetInstance()};
-        const PresetManager::PresetSet* presets;
-
-        switch (category) {
-            case PresetCategory::PresetCategoryFemale:
-                presets = &presetContainer.femalePresets;
-                break;
-            case PresetCategory::PresetCategoryFemaleBlacklisted:
-                presets = &presetContainer.blacklistedFemalePresets;
-                break;
-            case PresetCategory::PresetCategoryMale:
-                presets = &presetContainer.malePresets;
-                break;
-            case PresetCategory::PresetCategoryMaleBlacklisted:
-                presets = &presetContainer.blacklistedMalePresets;
-                break;
-            default:
-                presets = nullptr;
-        }
+        Reload::ReadGuard const readGuard;
+
+        const auto presets{GetPresetsOfCategory(category)};
 
         if (presets == nullptr) {
             return 0;
@@ -99,22 +115,28 @@ namespace OBody::API {
     }
 
     void PluginInterface::EnsureActorIsProcessed(Actor* a_actor) {
+        Reload::ReadGuard const readGuard;
         Body::OBody::GetInstance().GenerateActorBody(a_actor, this);
     }
 
     void PluginInterface::ApplyOBodyMorphsToActor(Actor* a_actor) {
+        Reload::ReadGuard const readGuard;
         Body::OBody::GetInstance().ReapplyActorMorphs(a_actor, this);
     }
 
     void PluginInterface::RemoveOBodyMorphsFromActor(Actor* a_actor) {
+        Reload::ReadGuard const readGuard;
         Body::OBody::GetInstance().ClearActorMorphs(a_actor, true, this);
     }
 
     void PluginInterface::ForcefullyChangeORefitForActor(Actor* a_actor, bool orefitShouldBeApplied) {
+        Reload::ReadGuard const readGuard;
         Body::OBody::GetInstance().ForcefullyChangeORefit(a_actor, orefitShouldBeApplied, this);
     }
 
     void PluginInterface::GetPresetAssignedToActor(Actor* a_actor, PresetAssignmentInformation& payload) {
+        Reload::ReadGuard const readGuard;
+
         bool isFemale = Body::OBody::GetInstance().IsFemale(a_actor);
 
         static_assert(PresetAssignmentInformation::Flags::IsFemale == 1);
@@ -142,58 +164,72 @@ namespace OBody::API {
     }
 
     bool PluginInterface::AssignPresetToActor(Actor* a_actor, AssignPresetPayload& payload) {
+        Reload::ReadGuard const readGuard;
+
+        if ((payload.presetName.size() == 0) | (payload.presetName.data() == nullptr)) {
+            UnassignPreset(a_actor, payload);
+            return true;
+        }
+
+        auto preset = PresetManager::GetPresetByNameForRandom(payload.presetName, Body::OBody::IsFemale(a_actor));
+
+        if (!preset) {
+            return false;
+        }
+
+        AssignPreset(a_actor, *preset, payload);
+        return true;
+    }
+
+    void PluginInterface::UnassignPreset(Actor* a_actor, const AssignPresetPayload& payload) {
         const auto& obody{Body::OBody::GetInstance()};
         auto& registry{ActorTracker::Registry::GetInstance()};
         auto formID = a_actor->formID;
 
-        if ((payload.presetName.size() == 0) | (payload.presetName.data() == nullptr)) {
-            // Clear their preset assignment, if they have one.
-            uint32_t previousPresetIndex = 0;
-            registry.stateForActor.visit(formID, [&](auto& entry) {
-                previousPresetIndex = entry.second.presetIndex;
-                entry.second.presetIndex = 0;
-            });
-
-            if ((payload.flags & AssignPresetPayload::Flags::DoNotApplyMorphs) == 0) {
-                bool immediate = (payload.flags & AssignPresetPayload::Flags::ForceImmediateApplicationOfMorphs) != 0;
-                obody.ClearActorMorphs(a_actor, immediate, this);
-            }
-
-            if (previousPresetIndex != 0) {
-                obody.SendActorChangeEvent(
-                    a_actor,
-                    [&] {
-                        using Event = ::OBody::API::IActorChangeEventListener;
-
-                        Event::OnActorPresetChangedWithoutGeneration::Payload payload{
-                            this,
-                            // Note that the plugin-API mandates that this be a null-terminated string.
-                            // Minus one because an index of zero assigned to the actor signifies the absence of a
-                            // preset.
-                            PresetManager::AssignedPresetIndex{previousPresetIndex - 1}.GetPresetNameView(
-                                obody.IsFemale(a_actor))};
-
-                        auto flags = Event::OnActorPresetChangedWithoutGeneration::Flags::PresetWasUnassigned;
-
-                        return std::make_pair(flags, payload);
-                    },
-                    [](auto listener, auto actor, auto&& args) {
-                        listener->OnActorPresetChangedWithoutGeneration(actor, args.first, args.second);
-                    });
-            }
+        // Clear their preset assignment, if they have one.
+        uint32_t previousPresetIndex = 0;
+        registry.stateForActor.visit(formID, [&](auto& entry) {
+            previousPresetIndex = entry.second.presetIndex;
+            entry.second.presetIndex = 0;
+        });
 
-            return true;
+        if ((payload.flags & AssignPresetPayload::Flags::DoNotApplyMorphs) == 0) {
+            bool immediate = (payload.flags & AssignPresetPayload::Flags::ForceImmediateApplicationOfMorphs) != 0;
+            obody.ClearActorMorphs(a_actor, immediate, this);
         }
 
-        bool isFemale = obody.IsFemale(a_actor);
+        if (previousPresetIndex != 0) {
+            obody.SendActorChangeEvent<::OBody::API::ActorChangeEventActorPresetChangedWithoutGeneration>(
+                a_actor,
+                [&] {
+                    using Event = ::OBody::API::IActorChangeEventListener;
 
-        const auto& presetContainer{PresetManager::PresetContainer::GetInstance()};
-        auto preset = GetPresetByNameForRandom(
-            isFemale ? presetContainer.allFemalePresets : presetContainer.allMalePresets, payload.presetName);
+                    // Minus one because an index of zero assigned to the actor signifies the absence of a preset.
+                    const PresetManager::AssignedPresetIndex presetIndex{previousPresetIndex - 1};
+                    // Note that the plugin-API mandates that this be a null-terminated string.
+                    const auto presetName{presetIndex.GetPresetNameView(obody.IsFemale(a_actor))};
 
-        if (!preset) {
-            return false;
+                    // The preset may have gone since, such as to a reload, leaving no index to speak of.
+                    Event::OnActorPresetChangedWithoutGeneration::Payload payload{
+                        this, presetName,
+                        presetName.empty() ? ::OBody::API::IPluginInterfaceV2::NoPresetIndex : presetIndex.value};
+
+                    auto flags = Event::OnActorPresetChangedWithoutGeneration::Flags::PresetWasUnassigned;
+
+                    return std::make_pair(flags, payload);
+                },
+                [](auto listener, auto actor, auto&& args) {
+                    listener->OnActorPresetChangedWithoutGeneration(actor, args.first, args.second);
+                });
         }
+    }
+
+    void PluginInterface::AssignPreset(Actor* a_actor, const PresetManager::Preset& preset,
+                                       const AssignPresetPayload& payload) {
+        const auto& obody{Body::OBody::GetInstance()};
+        auto& registry{ActorTracker::Registry::GetInstance()};
+        auto formID = a_actor->formID;
+        bool isFemale = obody.IsFemale(a_actor);
 
         // Like OBody::GenerateBodyByName, we set this morph to prevent a crash with SynthEBD/Synthesis.
         if (obody.synthesisInstalled) {
@@ -202,10 +238,10 @@ namespace OBody::API {
 
         if ((payload.flags & AssignPresetPayload::Flags::DoNotApplyMorphs) == 0) {
             bool immediate = (payload.flags & AssignPresetPayload::Flags::ForceImmediateApplicationOfMorphs) != 0;
-            obody.GenerateBodyByPreset(a_actor, *preset, immediate, this);
+            obody.GenerateBodyByPreset(a_actor, preset, immediate, this);
         } else {
             // Assign the preset to the actor.
-            auto assignedPresetIndex = preset->assignedIndex;
+            auto assignedPresetIndex = preset.assignedIndex;
             // Plus one because an index of zero on the actor signifies the absence of a preset.
             uint32_t actorPresetIndex = assignedPresetIndex.value + 1;
             ActorTracker::ActorState fallbackActorState{};
@@ -214,7 +250,7 @@ namespace OBody::API {
             registry.stateForActor.emplace_or_visit(formID, fallbackActorState,
                                                     [&](auto& entry) { entry.second.presetIndex = actorPresetIndex; });
 
-            obody.SendActorChangeEvent(
+            obody.SendActorChangeEvent<::OBody::API::ActorChangeEventActorPresetChangedWithoutGeneration>(
                 a_actor,
                 [&] {
                     using Event = ::OBody::API::IActorChangeEventListener;
@@ -222,7 +258,7 @@ namespace OBody::API {
                     Event::OnActorPresetChangedWithoutGeneration::Payload payload{
                         this,
                         // Note that the plugin-API mandates that this be a null-terminated string.
-                        assignedPresetIndex.GetPresetNameView(isFemale)};
+                        assignedPresetIndex.GetPresetNameView(isFemale), assignedPresetIndex.value};
 
                     Event::OnActorPresetChangedWithoutGeneration::Flags flags{};
 
@@ -232,9 +268,169 @@ namespace OBody::API {
                     listener->OnActorPresetChangedWithoutGeneration(actor, args.first, args.second);
                 });
         }
+    }
+
+    void PluginInterface::RegenerateLoadedActors(RegenerateLoadedActorsPayload& payload) {
+        const bool keepAssignedPresets{(payload.flags & RegenerateLoadedActorsPayload::Flags::KeepAssignedPresets) !=
+                                       0};
+
+        std::function<void(std::size_t)> onComplete;
+        if (payload.onComplete) {
+            onComplete = [onComplete = payload.onComplete, context = payload.context](const std::size_t actorCount) {
+                onComplete(context, actorCount);
+            };
+        }
+
+        Body::OBody::GetInstance().RegenerateLoadedActors(keepAssignedPresets, this, std::move(onComplete));
+    }
+
+    size_t PluginInterface::GetStageTimings(StageTimings* buffer, const size_t bufferLength) {
+        static_assert(std::size(StageTimings{}.histogram) == Instrumentation::HistogramBucketCount);
+
+        // The timings are only part of the interface from v2 onwards.
+        if (version < ::OBody::API::PluginAPIVersion::v2) return 0;
+
+        for (size_t i = 0; i < std::min(bufferLength, Instrumentation::StageCount); ++i) {
+            const auto stage{static_cast<Instrumentation::Stage>(i)};
+            const auto timings{Instrumentation::GetTimings(stage)};
+
+            buffer[i].stageName = Instrumentation::GetStageName(stage);
+            buffer[i].count = timings.count;
+            buffer[i].totalNanoseconds = timings.totalNanoseconds;
+            buffer[i].maxNanoseconds = timings.maxNanoseconds;
+            std::ranges::copy(timings.histogram, buffer[i].histogram);
+        }
+
+        return Instrumentation::StageCount;
+    }
+
+    void PluginInterface::GetActorStates(Actor* const* actors, const size_t actorCount, ActorStateFlags* flagsBuffer,
+                                         uint32_t* presetIndexBuffer) {
+        const auto& obody{Body::OBody::GetInstance()};
+        const auto& registry{ActorTracker::Registry::GetInstance()};
+
+        for (size_t i = 0; i < actorCount; ++i) {
+            const auto actor{actors[i]};
+
+            if (actor == nullptr) {
+                if (flagsBuffer != nullptr) flagsBuffer[i] = ActorStateFlags::ActorStateNone;
+                if (presetIndexBuffer != nullptr) presetIndexBuffer[i] = NoPresetIndex;
+                continue;
+            }
+
+            // The one lookup serves both buffers, and the morph flags too, unless they aren't known yet.
+            ActorTracker::ActorState state{};
+            registry.stateForActor.cvisit(actor->formID, [&](const auto& entry) { state = entry.second; });
+
+            if (flagsBuffer != nullptr) {
+                Body::MorphFlags morphFlags{static_cast<bool>(state.isProcessed),
+                                            static_cast<bool>(state.isBlacklisted),
+                                            static_cast<bool>(state.isClotheActive)};
+                if (!state.morphFlagsAreKnown) morphFlags = obody.GetMorphFlags(actor);
+
+                uint32_t flags{ActorStateFlags::ActorStateNone};
+                if (morphFlags.isProcessed) flags |= ActorStateFlags::ActorStateIsProcessed;
+                if (morphFlags.isBlacklisted) flags |= ActorStateFlags::ActorStateIsBlacklisted;
+                if (morphFlags.isClotheActive) flags |= ActorStateFlags::ActorStateHasORefitApplied;
+                if (Body::OBody::IsFemale(actor)) flags |= ActorStateFlags::ActorStateIsFemale;
+
+                flagsBuffer[i] = static_cast<ActorStateFlags>(flags);
+            }
+
+            if (presetIndexBuffer != nullptr) {
+                // Minus one because an index of zero assigned to the actor signifies the absence of a preset.
+                presetIndexBuffer[i] = state.presetIndex == 0 ? NoPresetIndex : state.presetIndex - 1;
+            }
+        }
+    }
+
+    size_t PluginInterface::GetPresets(PresetCategory category, PresetInformation* buffer, size_t bufferLength,
+                                       size_t offset, size_t limit) {
+        Reload::ReadGuard const readGuard;
+
+        const auto presets{GetPresetsOfCategory(category)};
+
+        if (presets == nullptr) {
+            return 0;
+        }
+
+        size_t presetCount = presets->size();
+        limit = std::min(bufferLength, limit);
+
+        size_t index = 0;
+        for (size_t presetIndex = offset; (presetIndex < presetCount) & (index < limit); ++presetIndex, ++index) {
+            const auto& preset = (*presets)[presetIndex];
+            buffer[index] = {preset.assignedIndex.value, {preset.name.data(), preset.name.size()}};
+        }
+
+        return index;
+    }
+
+    bool PluginInterface::AssignPresetIndexToActor(Actor* a_actor, const uint32_t presetIndex,
+                                                   AssignPresetPayload& payload) {
+        Reload::ReadGuard const readGuard;
+
+        if (presetIndex == NoPresetIndex) {
+            UnassignPreset(a_actor, payload);
+            return true;
+        }
 
+        const auto preset{PresetManager::AssignedPresetIndex{presetIndex}.GetPreset(Body::OBody::IsFemale(a_actor))};
+
+        if (!preset) {
+            return false;
+        }
+
+        AssignPreset(a_actor, *preset, payload);
         return true;
     }
+
+    bool PluginInterface::SubscribeEventListener(IActorChangeEventListener& eventListener,
+                                                 EventListenerSubscription& subscription) {
+        Body::ActorChangeEventSubscription actorChangeEventSubscription{
+            .eventKinds = subscription.eventKinds,
+            .coalesceClothingUpdates =
+                (subscription.flags & EventListenerSubscription::Flags::CoalesceClothingUpdates) != 0};
+
+        if (subscription.actorCount != 0) {
+            auto actors{std::make_shared<boost::unordered_flat_set<RE::FormID>>()};
+            actors->reserve(subscription.actorCount);
+
+            for (size_t i = 0; i < subscription.actorCount; ++i) {
+                if (subscription.actors[i] != nullptr) actors->insert(subscription.actors[i]->formID);
+            }
+
+            actorChangeEventSubscription.actors = std::move(actors);
+        }
+
+        return Body::OBody::GetInstance().SubscribeEventListener(eventListener, actorChangeEventSubscription);
+    }
+
+    bool PluginInterface::ReloadConfig(ReloadConfigPayload& payload) {
+        Reload::OnComplete onComplete;
+        if (payload.onComplete) {
+            onComplete = [onComplete = payload.onComplete, context = payload.context](
+                             const bool succeeded, const std::size_t actorCount) {
+                onComplete(context, succeeded, actorCount);
+            };
+        }
+
+        return Reload::Request(this, std::move(onComplete));
+    }
+
+    void PluginInterface::GetPresetNameOfIndex(const uint32_t presetIndex, const bool isFemale,
+                                               std::string_view& presetName) {
+        Reload::ReadGuard const readGuard;
+
+        if (presetIndex == NoPresetIndex) {
+            presetName = ""sv;
+            return;
+        }
+
+        // Note that the plugin-API mandates that this be a null-terminated string.
+        const auto preset{PresetManager::AssignedPresetIndex{presetIndex}.GetPreset(isFemale)};
+        presetName = preset != nullptr ? std::string_view{preset->name.data(), preset->name.size()} : ""sv;
+    }
 }  // namespace OBody::API
 
 #pragma pop_macro("max")
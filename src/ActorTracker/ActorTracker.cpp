@@ -2,8 +2,82 @@
 
 #include "ActorTracker/ActorTracker.h"
 
+#include "Body/Body.h"
+#include "JSONParser/JSONParser.h"
+
 ActorTracker::Registry ActorTracker::Registry::instance;
 
 namespace ActorTracker {
     Registry& Registry::GetInstance() { return instance; }
+
+    namespace {
+        // Runtime-created references, such as leveled spawns, have form-IDs of the 0xFF "plugin",
+        // which the game recycles once the references are gone.
+        bool IsRuntimeFormID(const RE::FormID a_formID) { return (a_formID >> 24) == 0xFF; }
+
+        // Whether the distribution rules would give the actor the preset of the given index anyway,
+        // leaving no choice to be remembered.
+        bool IsPresetImpliedByRules(RE::Actor* a_actor, const uint32_t a_presetIndex) {
+            const auto* actorBase{a_actor->GetActorBase()};
+            if (!actorBase) return false;
+
+            const auto decision{
+                Parser::JSONParser::GetInstance().GetDistributionDecision(actorBase, Body::OBody::IsFemale(a_actor))};
+
+            using Outcome = Parser::DistributionDecision::Outcome;
+            if (decision.outcome == Outcome::Blacklisted || !decision.presets || decision.presets->size() != 1) {
+                return false;
+            }
+
+            // Plus one because an index of zero on the actor signifies the absence of a preset.
+            return decision.presets->front()->assignedIndex.value + 1 == a_presetIndex;
+        }
+    }  // namespace
+
+    void Registry::CollectGarbage() {
+        [[maybe_unused]] stl::timeit const t;
+
+        const auto entryCount{stateForActor.size()};
+        std::size_t goneCount{0};
+        std::size_t deletedCount{0};
+        std::size_t deadCount{0};
+
+        stateForActor.erase_if([&](const auto& entry) {
+            const auto [formID, actorState]{entry};
+            // Events are being sent for the actor, and the sender expects to find their entry afterwards.
+            if (actorState.actorChangeEventsAreBeingSent) return false;
+
+            const bool hasPersistedState{(actorState.value & ActorState::PersistedInCosaveMask) != 0};
+
+            auto drop = [&](std::size_t& count) {
+                ++count;
+                oRefitBaselineForActor.erase(formID);
+                return true;
+            };
+
+            auto* actor{RE::TESForm::LookupByID<RE::Actor>(formID)};
+
+            if (!actor) {
+                // The references of plugins are only around while their cells are loaded, so their entries are
+                // kept for when they come back, but there's nothing to come back for past a runtime-created one.
+                return !hasPersistedState || IsRuntimeFormID(formID) ? drop(goneCount) : false;
+            }
+
+            if (actor->IsDeleted()) return drop(deletedCount);
+
+            // Dead leveled spawns only stick around until their cell resets, and we needn't wait until then
+            // should they have nothing for us to remember.
+            if (IsRuntimeFormID(formID) && actor->IsDead() &&
+                (!hasPersistedState || IsPresetImpliedByRules(actor, actorState.presetIndex))) {
+                return drop(deadCount);
+            }
+
+            return false;
+        });
+
+        logger::info(
+            "Collected the actor-registry's garbage: {} of {} entries dropped, {} for forms that are gone, {} for "
+            "deleted actors and {} for dead leveled actors.",
+            goneCount + deletedCount + deadCount, entryCount, goneCount, deletedCount, deadCount);
+    }
 }  // namespace ActorTracker
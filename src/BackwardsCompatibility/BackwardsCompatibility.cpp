@@ -22,6 +22,8 @@ namespace BackwardsCompatibility {
     }
 
     bool State::MigrateStorageUtilPresetAssignmentsOverToSKSECosave(const StorageUtilFunctions& storageUtil) {
+        [[maybe_unused]] stl::timeit const t;
+
         logger::info("Migrating legacy StorageUtil preset assignments over to the SKSE cosave.");
 
         uint32_t stringKeyCount = storageUtil.getStringKeyCount(nullptr, nullptr);
@@ -97,9 +99,6 @@ namespace BackwardsCompatibility {
             if (indexAssignment.second) {
                 // This is a preset name we haven't seen before.
                 ++nextPresetIndex.value;
-                // The sparse-index is mapped to -1 because the preset is absent.
-                (isFemale ? presets.allFemalePresetsByIndex : presets.allMalePresetsByIndex)
-                    .resize(nextPresetIndex.value, (PresetManager::SparsePresetIndex)-1);
 
                 // Maybe the actor's sex has changed since the preset was assigned?
                 auto& presetIndexMapOtherSex =
@@ -111,9 +110,6 @@ namespace BackwardsCompatibility {
                 if (indexAssignmentOtherSex.second) {
                     // This is also a preset name we haven't seen before.
                     ++nextPresetIndexOtherSex.value;
-                    // The sparse-index is mapped to -1 because the preset is absent.
-                    (isFemale ? presets.allMalePresetsByIndex : presets.allFemalePresetsByIndex)
-                        .resize(nextPresetIndexOtherSex.value, (PresetManager::SparsePresetIndex)-1);
                 }
             }
 
@@ -133,6 +129,13 @@ namespace BackwardsCompatibility {
             }
         }
 
+        // The sparse-indexes of the preset names we've just seen are mapped to -1, because the presets are absent.
+        // We only grow the mappings the once, now that we know how many names there are.
+        presets.allFemalePresetsByIndex.resize(presets.nextFemalePresetIndex.value,
+                                               static_cast<PresetManager::SparsePresetIndex>(-1));
+        presets.allMalePresetsByIndex.resize(presets.nextMalePresetIndex.value,
+                                             static_cast<PresetManager::SparsePresetIndex>(-1));
+
         logger::info("Migrated legacy StorageUtil preset assignments over to the SKSE cosave!");
         return true;
     }
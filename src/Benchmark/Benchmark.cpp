@@ -0,0 +1,198 @@
+#include "Benchmark/Benchmark.h"
+
+#include "Body/Body.h"
+#include "Instrumentation/Instrumentation.h"
+#include "JSONParser/JSONParser.h"
+#include "PresetManager/PresetManager.h"
+#include "SaveFileState/SaveFileState.h"
+
+namespace Benchmark {
+    namespace {
+        // Enough for the registry of a long playthrough.
+        constexpr uint32_t SyntheticActorCount = 50000;
+
+        // Runs the function the given number of times, and logs how long the runs took, on average and at best.
+        template <typename Function>
+        void Measure(const std::string_view a_name, const uint32_t a_iterations, const std::size_t a_itemCount,
+                     Function&& a_function) {
+            using namespace std::chrono;
+
+            nanoseconds total{0};
+            nanoseconds best{nanoseconds::max()};
+
+            for (uint32_t i = 0; i < a_iterations; ++i) {
+                const auto start{steady_clock::now()};
+                a_function();
+                const auto time{steady_clock::now() - start};
+
+                total += time;
+                best = std::min<nanoseconds>(best, time);
+            }
+
+            const auto average{total / std::max(a_iterations, 1u)};
+            logger::info("Benchmark {}: {} items, {} us on average, {} us at best, {} ns per item on average", a_name,
+                         a_itemCount, duration_cast<microseconds>(average).count(),
+                         duration_cast<microseconds>(best).count(),
+                         a_itemCount != 0 ? average.count() / static_cast<int64_t>(a_itemCount) : 0);
+        }
+
+        std::vector<RE::NiPointer<RE::Actor>> GetLoadedActors() {
+            std::vector<RE::NiPointer<RE::Actor>> actors;
+
+            if (const auto* processLists{RE::ProcessLists::GetSingleton()}) {
+                actors.reserve(processLists->highActorHandles.size());
+
+                for (const auto& actorHandle : processLists->highActorHandles) {
+                    auto actor{actorHandle.get()};
+                    if (actor && actor->Is3DLoaded() && actor->HasKeywordString("ActorTypeNPC") && !actor->IsChild()) {
+                        actors.push_back(std::move(actor));
+                    }
+                }
+            }
+
+            return actors;
+        }
+
+        // A registry like that of a long playthrough: actors spread over a few dozen plugins, their form-IDs
+        // close together within each, and most of them sharing one of a handful of presets.
+        // It's drawn from a generator of its own, so that it's the same every run, and the draws of the generator
+        // that the player may have seeded are left be.
+        void FillSyntheticRegistry(ActorTracker::Registry& a_registry) {
+            a_registry.stateForActor.reserve(SyntheticActorCount);
+
+            stl::xoshiro256ss generator{SyntheticActorCount};
+            std::uniform_int_distribution<uint32_t> formIDGap{1, 16};
+            std::uniform_int_distribution<uint32_t> presetIndex{1, 8};
+
+            RE::FormID formID{0};
+            for (uint32_t i = 0; i < SyntheticActorCount; ++i) {
+                if (i % 2000 == 0) formID = (i / 2000) << 24;
+                formID += formIDGap(generator);
+
+                ActorTracker::ActorState actorState{};
+                actorState.presetIndex = presetIndex(generator);
+                a_registry.stateForActor.emplace(formID, actorState);
+            }
+        }
+
+        void RunOnMainThread(const uint32_t a_iterations) {
+            [[maybe_unused]] stl::timeit const t;
+
+            const auto& obody{Body::OBody::GetInstance()};
+            auto& jsonParser{Parser::JSONParser::GetInstance()};
+            const auto actors{GetLoadedActors()};
+
+            logger::info("Running the benchmarks over {} loaded actors, {} times each.", actors.size(), a_iterations);
+
+            // The per-actor log lines would otherwise make up most of what we measure.
+            const bool actorLogging{Instrumentation::actorLogging.exchange(false)};
+            // Nor should our runs of the stages be counted among those of the game.
+            const bool recordingPaused{std::exchange(Instrumentation::recordingPaused, true)};
+            // Choosing presets draws from the random generator of this thread, which would put the player's seed,
+            // if they set one, out of step with what they'd otherwise get, so we put it back as it was once we're done.
+            const auto randomEngine{stl::detail::random_engine()};
+
+            Measure("DistributionDecision", a_iterations, actors.size(), [&] {
+                for (const auto& actor : actors) {
+                    const bool female{Body::OBody::IsFemale(actor.get())};
+                    [[maybe_unused]] const auto decision{
+                        jsonParser.GetDistributionDecision(actor->GetActorBase(), female)};
+                    [[maybe_unused]] const bool pluginIsBlacklisted{
+                        jsonParser.IsNPCPluginBlacklisted(actor.get(), female)};
+                }
+            });
+
+            Measure("ChooseGeneration", a_iterations, actors.size(), [&] {
+                for (const auto& actor : actors) {
+                    [[maybe_unused]] const auto choice{Body::OBody::ChooseGeneration(actor.get())};
+                }
+            });
+
+            Measure("EquipClassification", a_iterations, actors.size(), [&] {
+                for (const auto& actor : actors) {
+                    [[maybe_unused]] const bool naked{Body::OBody::IsNaked(actor.get(), false, nullptr)};
+                }
+            });
+
+            // GetMorphFlags would store what RaceMenu tells it in the registry, so we time its two halves apiece.
+            Measure("MorphFlagsLookup", a_iterations, actors.size(), [&] {
+                const auto& registry{ActorTracker::Registry::GetInstance()};
+                for (const auto& actor : actors) {
+                    [[maybe_unused]] bool flagsAreKnown{false};
+                    registry.stateForActor.cvisit(
+                        actor->formID, [&](const auto& entry) { flagsAreKnown = entry.second.morphFlagsAreKnown; });
+                }
+            });
+
+            Measure("MorphFlagsQuery", a_iterations, actors.size(), [&] {
+                for (const auto& actor : actors) {
+                    [[maybe_unused]] const auto morphFlags{obody.QueryMorphFlags(actor.get())};
+                }
+            });
+
+            // The presets are parsed and given their indexes into sets of our own,
+            // leaving those in use, and the preset cache, be.
+            const auto& blacklistedPresets{
+                jsonParser.presetDistributionConfig["blacklistedPresetsFromRandomDistribution"]};
+            const auto presetFiles{PresetManager::ListPresetFiles(blacklistedPresets)};
+            PresetManager::PresetSets presets;
+
+            Measure("PresetParsing", a_iterations, presetFiles.paths.size(), [&] {
+                std::size_t invalidPresetFiles{0};
+                presets = PresetManager::ParsePresets(presetFiles, blacklistedPresets, invalidPresetFiles);
+            });
+
+            const auto& presetContainer{PresetManager::PresetContainer::GetInstance()};
+            auto femalePresetIndexByName{presetContainer.femalePresetIndexByName};
+            auto malePresetIndexByName{presetContainer.malePresetIndexByName};
+            auto nextFemalePresetIndex{presetContainer.nextFemalePresetIndex};
+            auto nextMalePresetIndex{presetContainer.nextMalePresetIndex};
+            PresetManager::SparsePresetMapping femalePresetsByIndex;
+            PresetManager::SparsePresetMapping malePresetsByIndex;
+
+            PresetManager::PresetSet allFemalePresets{presets.femalePresets};
+            allFemalePresets.insert_range(allFemalePresets.end(), presets.blacklistedFemalePresets);
+            PresetManager::PresetSet allMalePresets{presets.malePresets};
+            allMalePresets.insert_range(allMalePresets.end(), presets.blacklistedMalePresets);
+
+            Measure("PresetIndexAssignment", a_iterations, allFemalePresets.size() + allMalePresets.size(), [&] {
+                PresetManager::AssignPresetIndexesForSex(allFemalePresets, presets.femalePresets,
+                                                         presets.blacklistedFemalePresets, femalePresetIndexByName,
+                                                         femalePresetsByIndex, nextFemalePresetIndex);
+                PresetManager::AssignPresetIndexesForSex(allMalePresets, presets.malePresets,
+                                                         presets.blacklistedMalePresets, malePresetIndexByName,
+                                                         malePresetsByIndex, nextMalePresetIndex);
+            });
+
+            ActorTracker::Registry syntheticRegistry;
+            FillSyntheticRegistry(syntheticRegistry);
+
+            SaveFileState::MemoryRecord record;
+            const auto buffer{std::make_unique<uint8_t[]>(SaveFileState::BufferSize)};
+
+            Measure("CosaveWrite", a_iterations, SyntheticActorCount, [&] {
+                record.data.clear();
+                SaveFileState::WriteRecordDataForActorRegistryV1(&record, buffer.get(), syntheticRegistry);
+            });
+
+            Measure("CosaveRead", a_iterations, SyntheticActorCount, [&] {
+                ActorTracker::Registry loadedRegistry;
+                record.readOffset = 0;
+                SaveFileState::ReadRecordDataForActorRegistryV1(
+                    &record, buffer.get(), static_cast<uint32_t>(record.data.size()), loadedRegistry);
+            });
+
+            logger::info("Benchmark cosave: {} actors take up {} bytes, against {} bytes for the v0 format.",
+                         SyntheticActorCount, record.data.size(),
+                         SyntheticActorCount * (sizeof(RE::FormID) + sizeof(ActorTracker::ActorState)));
+
+            stl::detail::random_engine() = randomEngine;
+            Instrumentation::recordingPaused = recordingPaused;
+            Instrumentation::actorLogging.store(actorLogging);
+        }
+    }  // namespace
+
+    void Run(const uint32_t a_iterations) {
+        SKSE::GetTaskInterface()->AddTask([a_iterations] { RunOnMainThread(std::max(a_iterations, 1u)); });
+    }
+}  // namespace Benchmark
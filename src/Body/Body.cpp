@@ -1,5 +1,7 @@
 #include "Body/Body.h"
 
+#include "Body/GenerationQueue.h"
+#include "Body/MorphScheduler.h"
 #include "JSONParser/JSONParser.h"
 #include "STL.h"
 
@@ -8,6 +10,32 @@ using namespace PresetManager;
 Body::OBody Body::OBody::instance_;
 
 namespace Body {
+    namespace {
+        template <typename GetMorph>
+        ORefit::Baseline DeriveBaseline(GetMorph&& a_getMorph) {
+            ORefit::Baseline baseline;
+
+            std::size_t i{0};
+            for (const auto& slider : ORefit::Sliders) {
+                if (slider.derived) baseline.derivedValues[i++] = slider.min - a_getMorph(slider.name);
+            }
+
+            return baseline;
+        }
+
+        template <typename SetMorph>
+        void ForEachORefitSlider(const ORefit::Baseline& a_baseline, const float a_weight,
+                                 const bool a_nippleSlidersEnabled, SetMorph&& a_setMorph) {
+            std::size_t i{0};
+            for (const auto& slider : ORefit::Sliders) {
+                const float value{slider.derived ? a_baseline.derivedValues[i++]
+                                                 : ((slider.max - slider.min) * a_weight) + slider.min};
+
+                if (!slider.nipple || a_nippleSlidersEnabled) a_setMorph(slider.name, value);
+            }
+        }
+    }  // namespace
+
     OBody& OBody::GetInstance() { return instance_; }
 
     bool OBody::SetMorphInterface(SKEE::IBodyMorphInterface* a_morphInterface) {
@@ -35,9 +63,9 @@ namespace Body {
 
     void OBody::ApplyMorphs(RE::Actor* a_actor, const bool updateMorphsWithoutTimer,
                             const bool applyProcessedMorph) const {
-        // If updateMorphsWithoutTimer is true, OBody NG will call the ApplyBodyMorphs function without waiting a random
-        // amount of time. That is useful for undressing/redressing.
-        // If performance mode is turned off, we also apply morphs randomly immediately no matter the context.
+        // If updateMorphsWithoutTimer is true, OBody NG will call the ApplyBodyMorphs function right away, rather than
+        // leaving it to the morph scheduler. That is useful for undressing/redressing.
+        // If performance mode is turned off, we also apply morphs immediately no matter the context.
 
         RE::ActorHandle actorHandle{a_actor->GetHandle()};
 
@@ -45,52 +73,49 @@ namespace Body {
             if (RE::Actor* actor = actorHandle.get().get()) {
                 if (applyProcessedMorph) {
                     SetMorph(actor, distributionKey.c_str(), "OBody", 1.0F);
+                    UpdateMorphFlags(actor, [](auto& state) { state.isProcessed = true; });
                 }
 
                 // ReSharper disable once CppDFAConstantConditions
                 if (actor && actor->Is3DLoaded()) {
+                    Instrumentation::ScopedTimer const timer{Instrumentation::Stage::SKEECalls};
                     morphInterface->ApplyBodyMorphs(actor, true);
                     NotifyMorphApplied(actor);
                 }
             }
         } else {
-            // ReSharper disable CppDFAUnreadVariable
-            // ReSharper disable CppDFAUnusedValue
-            auto actorName{a_actor->GetActorBase()->GetName()};
-
             // We do this to prevent stutters due to Racemenu attempting to update morphs for too many NPCs
-            std::thread([this, actorHandle, actorName] {
-                if (RE::Actor * actor{actorHandle.get().get()}) {
-                    logger::info("Actor {} is valid, updating morphs now", actorName);
+            MorphScheduler::GetInstance().Schedule(a_actor, applyProcessedMorph);
+        }
+    }
 
-                    SetMorph(actor, distributionKey.c_str(), "OBody", 1.0F);
+    void OBody::ApplyScheduledMorphs(RE::Actor* a_actor, const bool applyProcessedMorph) const {
+        OBODY_ACTOR_LOG("Actor {} is valid, updating morphs now", a_actor->GetName());
 
-                    // ReSharper disable once CppDFAConstantConditions
-                    if (actor && actor->Is3DLoaded() &&
-                        !morphInterface->HasBodyMorph(actor, "obody_synthebd", "OBody")) {
-                        morphInterface->ApplyBodyMorphs(actor, true);
+        if (applyProcessedMorph) {
+            SetMorph(a_actor, distributionKey.c_str(), "OBody", 1.0F);
+            UpdateMorphFlags(a_actor, [](auto& state) { state.isProcessed = true; });
+        }
 
-                        NotifyMorphApplied(actor);
-                    }
-                } else {
-                    logger::info("Actor {} is no longer valid, not updating morphs", actorName);
-                }
-            }).detach();
+        if (a_actor->Is3DLoaded() && !morphInterface->HasBodyMorph(a_actor, "obody_synthebd", "OBody")) {
+            Instrumentation::ScopedTimer const timer{Instrumentation::Stage::SKEECalls};
+            morphInterface->ApplyBodyMorphs(a_actor, true);
+
+            NotifyMorphApplied(a_actor);
         }
     }
 
     void OBody::ProcessActorEquipEvent(RE::Actor* a_actor, const bool a_removingArmor,
                                        const RE::TESForm* a_equippedArmor) const {
-        const bool isProcessed = IsProcessed(a_actor);
-        const bool isBlacklisted = IsBlacklisted(a_actor);
-        const bool clotheActive = IsClotheActive(a_actor);
-        const bool naked = IsNaked(a_actor, a_removingArmor, a_equippedArmor);
+        const auto [isProcessed, isBlacklisted, clotheActive]{GetMorphFlags(a_actor)};
+        const auto wornClothing{GetWornClothing(a_actor, a_removingArmor, a_equippedArmor)};
+        const bool naked = IsNaked(a_actor, wornClothing, a_removingArmor, a_equippedArmor);
         bool orefitIsApplied = clotheActive;
         bool female;
 
         if (!isProcessed | isBlacklisted) goto notifyNativeEventListeners;
 
-        if (IsRemovingClothes(a_actor, a_removingArmor, a_equippedArmor)) {
+        if (wornClothing.removingClothes) {
             OnActorRemovingClothes.SendEvent(a_actor);
         }
 
@@ -115,12 +140,12 @@ namespace Body {
         }
 
         if (clotheActive && naked) {
-            logger::info("Removing clothed preset to actor {}", a_actor->GetName());
+            OBODY_ACTOR_LOG("Removing clothed preset to actor {}", a_actor->GetName());
             RemoveClothePreset(a_actor);
             ApplyMorphs(a_actor, true);
             orefitIsApplied = false;
         } else if (!clotheActive && !naked && setRefit) {
-            logger::info("Applying clothed preset to actor {}", a_actor->GetName());
+            OBODY_ACTOR_LOG("Applying clothed preset to actor {}", a_actor->GetName());
             ApplyClothePreset(a_actor);
             ApplyMorphs(a_actor, true);
             orefitIsApplied = true;
@@ -130,7 +155,7 @@ namespace Body {
         // because if an event-listener equips or unequips armour in response to it it can
         // easily cause an infinite loop of `TESEquipEvent`s, which would freeze the game
         // until it crashes from a stack overflow.
-        SendActorChangeEvent(
+        SendActorChangeEvent<::OBody::API::ActorChangeEventActorClothingUpdate>(
             a_actor,
             [&] {
                 using Event = ::OBody::API::IActorChangeEventListener;
@@ -166,118 +191,262 @@ namespace Body {
             return;
         }
 
+        ApplyGenerationChoice(a_actor, ChooseGeneration(a_actor), responsibleInterface);
+    }
+
+    GenerationChoice OBody::ChooseGeneration(RE::Actor* a_actor) {
         bool female{IsFemale(a_actor)};
 
         auto& presetContainer{PresetManager::PresetContainer::GetInstance()};
 
         // If we have no presets at all for the actor's sex, then don't do anything
         if ((female && presetContainer.femalePresets.empty()) || !female && presetContainer.malePresets.empty()) {
-            return;
+            return {};
         }
 
         auto& jsonParser{Parser::JSONParser::GetInstance()};
 
         auto actorBase{a_actor->GetActorBase()};
         auto actorName{actorBase->GetName()};
-        auto actorID{actorBase->GetFormID()};
 
-        logger::info("Trying to find and apply preset to {}", actorName);
+        OBODY_ACTOR_LOG("Trying to find and apply preset to {}", actorName);
 
-        auto blacklistNPC = [&] {
-            SetMorph(a_actor, distributionKey.c_str(), "OBody", 1.0F);
-            SetMorph(a_actor, "obody_blacklisted", "OBody", 1.0F);
-
-            // Clear their preset assignment, if they have one.
-            auto& registry{ActorTracker::Registry::GetInstance()};
-            uint32_t previousPresetIndex = 0;
-            registry.stateForActor.visit(a_actor->formID, [&](auto& entry) {
-                previousPresetIndex = entry.second.presetIndex;
-                entry.second.presetIndex = 0;
-            });
-
-            if (previousPresetIndex != 0) {
-                SendActorChangeEvent(
-                    a_actor,
-                    [&] {
-                        using Event = ::OBody::API::IActorChangeEventListener;
-
-                        Event::OnActorPresetChangedWithoutGeneration::Payload payload{
-                            responsibleInterface,
-                            // Note that the plugin-API mandates that this be a null-terminated string.
-                            // Minus one because an index of zero assigned to the actor signifies the absence of a
-                            // preset.
-                            PresetManager::AssignedPresetIndex{previousPresetIndex - 1}.GetPresetNameView(female)};
-
-                        auto flags = Event::OnActorPresetChangedWithoutGeneration::Flags::PresetWasUnassigned;
-
-                        return std::make_pair(flags, payload);
-                    },
-                    [](auto listener, auto actor, auto&& args) {
-                        listener->OnActorPresetChangedWithoutGeneration(actor, args.first, args.second);
-                    });
-            }
-        };
+        // The rules only care for the actor's base, bar the plugin blacklist, so the decision is shared by every
+        // actor of the same base, and we only need to check the plugin of this actor's reference
+        using Outcome = Parser::DistributionDecision::Outcome;
+        const auto decision{jsonParser.GetDistributionDecision(actorBase, female)};
 
         // If NPC is blacklisted, set him as processed
-        if (jsonParser.IsNPCBlacklisted(actorName, actorID)) {
-            blacklistNPC();
-            return;
+        if (decision.outcome == Outcome::Blacklisted ||
+            (decision.outcome == Outcome::DistributedPresets && jsonParser.IsNPCPluginBlacklisted(a_actor, female))) {
+            return {GenerationChoice::kBlacklist};
+        }
+
+        const Preset* preset{decision.presets ? Parser::GetRandomPresetFromList(*decision.presets) : nullptr};
+
+        // If we got here without a preset, then we just fetch one randomly
+        if (preset == nullptr) {
+            OBODY_ACTOR_LOG("No preset defined for this actor, getting it randomly");
+            preset =
+                PresetManager::GetRandomPreset(female ? presetContainer.femalePresets : presetContainer.malePresets);
         }
 
-        // First, we attempt to get the NPC's preset from the keys npcFormID and npc from the JSON
-        std::optional<Preset> preset{jsonParser.GetNPCPreset(actorName, actorID, female)};
+        OBODY_ACTOR_LOG("Preset {} will be applied to {}", preset->name, actorName);
 
-        if (!preset.has_value()) {
-            auto actorRace{stl::get_editorID(actorBase->GetRace()->As<RE::TESForm>())};
+        return {GenerationChoice::kPreset, preset};
+    }
 
-            // if we can't find it, we check if the NPC is blacklisted by plugin name or by race
-            if (jsonParser.IsNPCBlacklistedGlobally(a_actor, actorRace.c_str(), female)) {
-                blacklistNPC();
+    void OBody::ApplyGenerationChoice(RE::Actor* a_actor, const GenerationChoice& a_choice,
+                                      ::OBody::API::IPluginInterface* responsibleInterface) const {
+        switch (a_choice.kind) {
+            case GenerationChoice::kNothing:
                 return;
-            }
+            case GenerationChoice::kBlacklist:
+                BlacklistActor(a_actor, responsibleInterface);
+                return;
+            case GenerationChoice::kPreset:
+                GenerateBodyByPreset(a_actor, *a_choice.preset, false, responsibleInterface);
+                return;
+        }
+    }
+
+    void OBody::BlacklistActor(RE::Actor* a_actor, ::OBody::API::IPluginInterface* responsibleInterface) const {
+        SetMorph(a_actor, distributionKey.c_str(), "OBody", 1.0F);
+        SetMorph(a_actor, "obody_blacklisted", "OBody", 1.0F);
+        UpdateMorphFlags(a_actor, [](auto& state) {
+            state.isProcessed = true;
+            state.isBlacklisted = true;
+        });
+
+        // Clear their preset assignment, if they have one.
+        auto& registry{ActorTracker::Registry::GetInstance()};
+        uint32_t previousPresetIndex = 0;
+        registry.stateForActor.visit(a_actor->formID, [&](auto& entry) {
+            previousPresetIndex = entry.second.presetIndex;
+            entry.second.presetIndex = 0;
+        });
+
+        if (previousPresetIndex != 0) {
+            SendActorChangeEvent<::OBody::API::ActorChangeEventActorPresetChangedWithoutGeneration>(
+                a_actor,
+                [&] {
+                    using Event = ::OBody::API::IActorChangeEventListener;
+
+                    // Minus one because an index of zero assigned to the actor signifies the absence of a preset.
+                    const PresetManager::AssignedPresetIndex presetIndex{previousPresetIndex - 1};
+                    // Note that the plugin-API mandates that this be a null-terminated string.
+                    const auto presetName{presetIndex.GetPresetNameView(IsFemale(a_actor))};
+
+                    // The preset may have gone since, such as to a reload, leaving no index to speak of.
+                    Event::OnActorPresetChangedWithoutGeneration::Payload payload{
+                        responsibleInterface, presetName,
+                        presetName.empty() ? ::OBody::API::IPluginInterfaceV2::NoPresetIndex : presetIndex.value};
+
+                    auto flags = Event::OnActorPresetChangedWithoutGeneration::Flags::PresetWasUnassigned;
+
+                    return std::make_pair(flags, payload);
+                },
+                [](auto listener, auto actor, auto&& args) {
+                    listener->OnActorPresetChangedWithoutGeneration(actor, args.first, args.second);
+                });
+        }
+    }
 
-            // Next up, we check if we have a preset defined in one of the NPC's factions
-            preset = jsonParser.GetNPCFactionPreset(actorBase, female);
+    void OBody::RegenerateLoadedActors(const bool a_keepAssignedPresets,
+                                       ::OBody::API::IPluginInterface* responsibleInterface,
+                                       std::function<void(std::size_t)> a_onComplete) const {
+        // The process lists are the game's, and are only to be walked on the main thread, as are the rules and presets
+        // that are chosen from, which a reload replaces there, so whatever thread we're called on, it's done in a task.
+        SKSE::GetTaskInterface()->AddTask([this, a_keepAssignedPresets, responsibleInterface,
+                                           onComplete = std::move(a_onComplete)]() mutable {
+            [[maybe_unused]] stl::timeit const t;
 
-            // If that also fails, we check if we have a preset in the NPC's plugin
-            if (!preset.has_value()) {
-                preset = jsonParser.GetNPCPluginPreset(actorBase, actorName, female);
+            std::vector<Regeneration> regenerations;
+
+            // The same actors that we'd generate upon their scripts being initialised.
+            if (const auto* processLists{RE::ProcessLists::GetSingleton()}) {
+                regenerations.reserve(processLists->highActorHandles.size());
+
+                for (const auto& actorHandle : processLists->highActorHandles) {
+                    auto actor{actorHandle.get()};
+                    if (!actor || !actor->Is3DLoaded() || !actor->HasKeywordString("ActorTypeNPC") ||
+                        actor->IsChild()) {
+                        continue;
+                    }
+
+                    PrepareRegeneration(regenerations.emplace_back(std::move(actor)), a_keepAssignedPresets);
+                }
             }
 
-            // And if that also fails, we check if we have a preset in the NPC's race
-            if (!preset.has_value()) {
-                preset = jsonParser.GetNPCRacePreset(actorRace.c_str(), female);
+            logger::info("Regenerating {} loaded actors", regenerations.size());
+
+            Regenerate(std::move(regenerations), a_keepAssignedPresets, responsibleInterface,
+                       [onComplete = std::move(onComplete)](const std::size_t a_regenerated) {
+                           logger::info("Regenerated {} loaded actors", a_regenerated);
+
+                           if (auto* evSrc = SKSE::GetModCallbackEventSource()) {
+                               SKSE::ModCallbackEvent ev{};
+                               ev.eventName = "OBody_LoadedActorsRegenerated";
+                               ev.numArg = static_cast<float>(a_regenerated);
+                               evSrc->SendEvent(&ev);
+                           }
+
+                           if (onComplete) onComplete(a_regenerated);
+                       });
+        });
+    }
+
+    void OBody::RegenerateActors(std::vector<RE::NiPointer<RE::Actor>> a_actors,
+                                 ::OBody::API::IPluginInterface* responsibleInterface,
+                                 std::function<void(std::size_t)> a_onComplete) const {
+        std::vector<Regeneration> regenerations;
+        regenerations.reserve(a_actors.size());
+        for (auto& actor : a_actors) regenerations.emplace_back(std::move(actor));
+
+        Regenerate(std::move(regenerations), false, responsibleInterface, std::move(a_onComplete));
+    }
+
+    void OBody::PrepareRegeneration(Regeneration& a_regeneration, const bool a_keepAssignedPresets) const {
+        if (!a_keepAssignedPresets) return;
+
+        auto* actor{a_regeneration.actor.get()};
+
+        // Like ReapplyActorMorphs, actors keep their preset, and only those without one are generated.
+        uint32_t actorPresetIndex = 0;
+        ActorTracker::Registry::GetInstance().stateForActor.cvisit(
+            actor->formID, [&](auto& entry) { actorPresetIndex = entry.second.presetIndex; });
+
+        if (actorPresetIndex != 0) {
+            // Minus one because an index of zero assigned to the actor signifies the absence of a preset.
+            const PresetManager::AssignedPresetIndex presetIndex{actorPresetIndex - 1};
+            if (const auto preset{presetIndex.GetPreset(IsFemale(actor))}) {
+                a_regeneration.choice = {GenerationChoice::kPreset, preset};
+                a_regeneration.choose = false;
+                return;
             }
         }
 
-        // If we got here without a preset, then we just fetch one randomly
-        if (!preset.has_value()) {
-            logger::info("No preset defined for this actor, getting it randomly");
-            preset =
-                PresetManager::GetRandomPreset(female ? presetContainer.femalePresets : presetContainer.malePresets);
+        if (IsProcessed(actor)) a_regeneration.choose = false;
+    }
+
+    void OBody::Regenerate(std::vector<Regeneration> a_regenerations, const bool a_keepAssignedPresets,
+                           ::OBody::API::IPluginInterface* responsibleInterface,
+                           std::function<void(std::size_t)> a_onComplete) const {
+        auto& presetContainer{PresetManager::PresetContainer::GetInstance()};
+        // The choices point into the presets, which a reload of the config may replace before the jobs are run.
+        const auto presetsRevision{presetContainer.revision.load(std::memory_order_acquire)};
+
+        // Making the choices only reads the compiled rules and the actors, so we can make them all in parallel.
+        // We're on the main thread, which we hold up until they're made, so a reload can't replace the rules meanwhile.
+        std::for_each(std::execution::par, a_regenerations.begin(), a_regenerations.end(), [](auto& regeneration) {
+            if (regeneration.choose) regeneration.choice = ChooseGeneration(regeneration.actor.get());
+        });
+
+        // The bodies are applied through the generation queue, so that they're spread over as many frames as need be.
+        // Every one of these runs on the main thread, so the progress needn't be atomic.
+        struct Progress {
+            std::size_t remaining;
+            std::size_t total;
+            std::function<void(std::size_t)> onComplete;
+        };
+
+        const auto progress{
+            std::make_shared<Progress>(a_regenerations.size(), a_regenerations.size(), std::move(a_onComplete))};
+
+        auto notifyCompletion = [](const Progress& a_progress) {
+            if (a_progress.onComplete) a_progress.onComplete(a_progress.total);
+        };
+
+        if (a_regenerations.empty()) {
+            SKSE::GetTaskInterface()->AddTask([progress, notifyCompletion] { notifyCompletion(*progress); });
+            return;
         }
 
-        logger::info("Preset {} will be applied to {}", preset->name, actorName);
+        auto& generationQueue{GenerationQueue::GetInstance()};
+        for (auto& regeneration : a_regenerations) {
+            generationQueue.Enqueue(
+                regeneration.actor->GetHandle(),
+                [this, &presetContainer, presetsRevision, choice = regeneration.choice, a_keepAssignedPresets,
+                 responsibleInterface, progress, notifyCompletion](RE::Actor* a_actor) mutable {
+                    if (a_actor) {
+                        // The presets were replaced since the choice was made, so its preset is no more.
+                        if (presetContainer.revision.load(std::memory_order_acquire) != presetsRevision) {
+                            Regeneration renewed{RE::NiPointer{a_actor}};
+                            PrepareRegeneration(renewed, a_keepAssignedPresets);
+                            choice = renewed.choose ? ChooseGeneration(a_actor) : renewed.choice;
+                        }
+
+                        // Actors that are now blacklisted shouldn't keep the body they were given before.
+                        if (!a_keepAssignedPresets && choice.kind == GenerationChoice::kBlacklist) {
+                            ClearActorMorphs(a_actor, false, responsibleInterface);
+                        }
+
+                        ApplyGenerationChoice(a_actor, choice, responsibleInterface);
+                    }
 
-        GenerateBodyByPreset(a_actor, *preset, false, responsibleInterface);
+                    if (--progress->remaining == 0) notifyCompletion(*progress);
+                });
+        }
     }
 
     void OBody::GenerateBodyByName(RE::Actor* a_actor, const std::string& a_name,
                                    ::OBody::API::IPluginInterface* responsibleInterface) const {
-        const auto& presetContainer{PresetContainer::GetInstance()};
-
         // This is needed to prevent a crash with SynthEBD/Synthesis
         if (synthesisInstalled && a_actor != nullptr) {
             SetMorph(a_actor, "obody_synthebd", "OBody", 1.0F);
         }
 
-        Preset preset{GetPresetByName(
-            IsFemale(a_actor) ? presetContainer.allFemalePresets : presetContainer.allMalePresets, a_name, true)};
+        const Preset* preset{GetPresetByName(a_name, IsFemale(a_actor))};
 
-        GenerateBodyByPreset(a_actor, preset, true, responsibleInterface);
+        if (preset == nullptr) {
+            OBODY_ACTOR_LOG("No preset could be found or chosen for the name {}", a_name);
+            return;
+        }
+
+        GenerateBodyByPreset(a_actor, *preset, true, responsibleInterface);
     }
 
-    void OBody::GenerateBodyByPreset(RE::Actor* a_actor, PresetManager::Preset& a_preset,
+    void OBody::GenerateBodyByPreset(RE::Actor* a_actor, const PresetManager::Preset& a_preset,
                                      const bool updateMorphsWithoutTimer,
                                      ::OBody::API::IPluginInterface* responsibleInterface) const {
         auto& registry{ActorTracker::Registry::GetInstance()};
@@ -292,53 +461,61 @@ namespace Body {
         registry.stateForActor.emplace_or_visit(formID, fallbackActorState,
                                                 [&](auto& entry) { entry.second.presetIndex = actorPresetIndex; });
 
+        // The morphs are collected into a batch, and only the ones that change are written to RaceMenu
+        MorphBatch batch{a_actor, morphInterface};
+        Instrumentation::ScopedTimer sliderBuild{Instrumentation::Stage::SliderBuild};
+
         // Start by clearing any previous OBody morphs
         if (setRespectfulMorphApplication) {
-            morphInterface->ClearBodyMorphKeys(a_actor, "OBody");
-            morphInterface->ClearBodyMorphKeys(a_actor, "OClothe");
+            batch.ClearKey("OBody");
+            batch.ClearKey("OClothe");
         } else {
             // For backwards compatibility we clear all morphs instead of just our own,
             // unless the user has opted-in for us to be more respectful.
-            morphInterface->ClearMorphs(a_actor);
+            batch.ClearAll();
         }
 
         // Apply the preset's sliders
-        ApplySliderSet(a_actor, a_preset.sliders, "OBody");
+        ApplyPresetSliders(batch, a_preset.sliders, "OBody");
 
-        logger::info("Applying preset: {}; index: {}", a_preset.name, a_preset.assignedIndex.value);
+        OBODY_ACTOR_LOG("Applying preset: {}; index: {}", a_preset.name, a_preset.assignedIndex.value);
 
         if (IsFemale(a_actor)) {
             // Generate random nipple sliders if needed
-            if (setNippleRand) {
-                PresetManager::SliderSet set{GenerateRandomNippleSliders()};
-                ApplySliderSet(a_actor, set, "OBody");
-            }
+            if (setNippleRand) ApplyRandomSliders(batch, RandomSliders::Nipple, "OBody");
 
-            if (setGenitalRand) {
-                // Generate random genital sliders if needed
-                PresetManager::SliderSet set{GenerateRandomGenitalSliders()};
-                ApplySliderSet(a_actor, set, "OBody");
-            }
+            // Generate random genital sliders if needed
+            if (setGenitalRand) ApplyRandomSliders(batch, RandomSliders::Genital, "OBody");
         }
 
+        // Work out ORefit's sliders now, while the actor's OBody morphs are at hand,
+        // so that equipping and unequipping armor later doesn't have to read them back
+        const ORefit::Baseline oRefitBaseline{DeriveORefitBaseline(batch)};
+        registry.oRefitBaselineForActor.insert_or_assign(formID, oRefitBaseline);
+
         bool isNaked = IsNaked(a_actor, false, nullptr);
         bool orefitIsApplied = false;
 
         // If not naked and if ORefit is turned on, apply ORefit morphing
         if (!isNaked) {
             if (setRefit) {
-                logger::info("Not naked, adding cloth preset");
-                ApplyClothePreset(a_actor);
+                OBODY_ACTOR_LOG("Not naked, adding cloth preset");
+                ApplyClothePreset(batch, oRefitBaseline);
                 orefitIsApplied = true;
             }
         } else {
-            logger::info("Actor is naked, not applying cloth preset");
+            OBODY_ACTOR_LOG("Actor is naked, not applying cloth preset");
             OnActorNaked.SendEvent(a_actor);
         }
 
+        sliderBuild.Stop();
+        batch.Flush();
+        // The batch cleared the morphs marking the actor as processed, which ApplyMorphs sets again, or blacklisted.
+        SetMorphFlags(a_actor, MorphFlags{.isClotheActive = orefitIsApplied});
+
         ApplyMorphs(a_actor, updateMorphsWithoutTimer);
 
-        SendActorChangeEvent(
+        SendActorChangeEvent<::OBody::API::ActorChangeEventActorGenerated>(
             a_actor,
             [&] {
                 using Event = ::OBody::API::IActorChangeEventListener;
@@ -346,7 +523,8 @@ namespace Body {
                 Event::OnActorGenerated::Payload payload{
                     responsibleInterface,
                     // Note that the plugin-API mandates that this be a null-terminated string.
-                    {a_preset.name.data(), a_preset.name.size()}};
+                    {a_preset.name.data(), a_preset.name.size()},
+                    a_preset.assignedIndex.value};
 
                 Event::OnActorGenerated::Flags flags{};
                 static_assert(Event::OnActorGenerated::Flags::IsClothed == (1 << 0));
@@ -363,29 +541,50 @@ namespace Body {
         OnActorGenerated.SendEvent(a_actor, a_preset.name);
     }
 
-    void OBody::ApplySlider(RE::Actor* a_actor, const PresetManager::Slider& a_slider, const char* a_key,
-                            const float a_weight) const {
-        const float val{((a_slider.max - a_slider.min) * a_weight) + a_slider.min};
-        morphInterface->SetMorph(a_actor, a_slider.name.c_str(), a_key, val);
-    }
+    void OBody::ApplyPresetSliders(MorphBatch& a_batch, const PresetManager::PresetSliders& a_sliders,
+                                   const char* a_key) {
+        const float weight{GetWeight(a_batch.GetActor())};
+        const auto count{a_sliders.size()};
 
-    void OBody::ApplySliderSet(RE::Actor* a_actor, PresetManager::SliderSet& a_sliders, const char* a_key) const {
-        const float weight{GetWeight(a_actor)};
-        for (const auto& slider : a_sliders | std::views::values) ApplySlider(a_actor, slider, a_key, weight);
+        // The buffers are kept from one call to the next, as this runs for every actor that's generated.
+        thread_local std::vector<float> values;
+        thread_local std::vector<const char*> names;
+
+        // We interpolate all the values up-front, in a loop free of calls, so that it can be vectorised.
+        values.resize(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            values[i] = ((a_sliders.maxes[i] - a_sliders.mins[i]) * weight) + a_sliders.mins[i];
+        }
+
+        // The names are resolved before we set any of the morphs, so that the table isn't locked while we do.
+        PresetManager::SliderNameTable::GetInstance().GetNames(a_sliders.nameIDs, names);
+
+        for (std::size_t i = 0; i < count; ++i) a_batch.Set(names[i], a_key, values[i]);
     }
 
     void OBody::ApplyClothePreset(RE::Actor* a_actor) const {
-        auto set{GenerateClotheSliders(a_actor)};
-        ApplySliderSet(a_actor, set, "OClothe");
+        const auto baseline{GetORefitBaseline(a_actor)};
+        ForEachORefitSlider(baseline, GetWeight(a_actor), setNippleSlidersRefitEnabled,
+                            [&](const char* a_name, const float a_value) {
+                                morphInterface->SetMorph(a_actor, a_name, "OClothe", a_value);
+                            });
+        UpdateMorphFlags(a_actor, [](auto& state) { state.isClotheActive = true; });
+    }
+
+    void OBody::ApplyClothePreset(MorphBatch& a_batch, const ORefit::Baseline& a_baseline) const {
+        ForEachORefitSlider(a_baseline, GetWeight(a_batch.GetActor()), setNippleSlidersRefitEnabled,
+                            [&](const char* a_name, const float a_value) { a_batch.Set(a_name, "OClothe", a_value); });
     }
 
     void OBody::ClearActorMorphs(RE::Actor* a_actor, bool updateMorphsWithoutTimer,
                                  ::OBody::API::IPluginInterface* responsibleInterface) const {
         morphInterface->ClearBodyMorphKeys(a_actor, "OBody");
         morphInterface->ClearBodyMorphKeys(a_actor, "OClothe");
+        ActorTracker::Registry::GetInstance().oRefitBaselineForActor.erase(a_actor->formID);
+        SetMorphFlags(a_actor, MorphFlags{});
         ApplyMorphs(a_actor, updateMorphsWithoutTimer, false);
 
-        SendActorChangeEvent(
+        SendActorChangeEvent<::OBody::API::ActorChangeEventActorMorphsCleared>(
             a_actor,
             [&] {
                 using Event = ::OBody::API::IActorChangeEventListener;
@@ -425,7 +624,7 @@ namespace Body {
         applied ? ApplyClothePreset(a_actor) : RemoveClothePreset(a_actor);
         ApplyMorphs(a_actor, true);
 
-        SendActorChangeEvent(
+        SendActorChangeEvent<::OBody::API::ActorChangeEventORefitForcefullyChanged>(
             a_actor,
             [&] {
                 using Event = ::OBody::API::IActorChangeEventListener;
@@ -444,279 +643,147 @@ namespace Body {
             });
     }
 
-    void OBody::RemoveClothePreset(RE::Actor* a_actor) const { morphInterface->ClearBodyMorphKeys(a_actor, "OClothe"); }
+    void OBody::RemoveClothePreset(RE::Actor* a_actor) const {
+        morphInterface->ClearBodyMorphKeys(a_actor, "OClothe");
+        UpdateMorphFlags(a_actor, [](auto& state) { state.isClotheActive = false; });
+    }
 
     float OBody::GetWeight(RE::Actor* a_actor) { return a_actor->GetActorBase()->GetWeight() / 100.0F; }
 
-    bool OBody::IsClotheActive(RE::Actor* a_actor) const { return morphInterface->HasBodyMorphKey(a_actor, "OClothe"); }
+    bool OBody::IsClotheActive(RE::Actor* a_actor) const { return GetMorphFlags(a_actor).isClotheActive; }
 
-    bool OBody::IsNaked(RE::Actor* a_actor, const bool a_removingArmor, const RE::TESForm* a_equippedArmor) {
-        auto& jsonParser{Parser::JSONParser::GetInstance()};
+    WornClothing OBody::GetWornClothing(RE::Actor* a_actor, const bool a_removingArmor,
+                                        const RE::TESForm* a_equippedArmor) {
+        using BipedObjectSlot = RE::BGSBipedObjectForm::BipedObjectSlot;
 
-        auto outfitBody{a_actor->GetWornArmor(RE::BGSBipedObjectForm::BipedObjectSlot::kBody)};
-        auto outergarmentChest{a_actor->GetWornArmor(RE::BGSBipedObjectForm::BipedObjectSlot::kModChestPrimary)};
-        auto undergarmentChest{a_actor->GetWornArmor(RE::BGSBipedObjectForm::BipedObjectSlot::kModChestSecondary)};
+        WornClothing wornClothing;
+        auto& slots{wornClothing.slots};
+        slots[WornClothing::kBody] = a_actor->GetWornArmor(BipedObjectSlot::kBody);
+        slots[WornClothing::kOutergarmentChest] = a_actor->GetWornArmor(BipedObjectSlot::kModChestPrimary);
+        slots[WornClothing::kUndergarmentChest] = a_actor->GetWornArmor(BipedObjectSlot::kModChestSecondary);
+        slots[WornClothing::kOutergarmentPelvis] = a_actor->GetWornArmor(BipedObjectSlot::kModPelvisPrimary);
+        slots[WornClothing::kUndergarmentPelvis] = a_actor->GetWornArmor(BipedObjectSlot::kModPelvisSecondary);
 
         // When the TES EquipEvent is sent, the inventory isn't updated yet
         // So we have to check if any of these armors is being removed...
         if (a_removingArmor) {
-            if (outfitBody == a_equippedArmor) {
-                outfitBody = nullptr;
-            } else if (outergarmentChest == a_equippedArmor) {
-                outergarmentChest = nullptr;
-            } else if (undergarmentChest == a_equippedArmor) {
-                undergarmentChest = nullptr;
+            for (auto& armor : slots) {
+                if (armor && armor == a_equippedArmor) {
+                    armor = nullptr;
+                    wornClothing.removingClothes = true;
+                    break;
+                }
             }
         }
 
+        return wornClothing;
+    }
+
+    bool OBody::IsNaked(RE::Actor* a_actor, const bool a_removingArmor, const RE::TESForm* a_equippedArmor) {
+        return IsNaked(a_actor, GetWornClothing(a_actor, a_removingArmor, a_equippedArmor), a_removingArmor,
+                       a_equippedArmor);
+    }
+
+    bool OBody::IsNaked(RE::Actor* a_actor, const WornClothing& a_wornClothing, const bool a_removingArmor,
+                        const RE::TESForm* a_equippedArmor) {
+        Instrumentation::ScopedTimer const timer{Instrumentation::Stage::EquipClassification};
+
+        auto& jsonParser{Parser::JSONParser::GetInstance()};
+
         // if outfit is blacklisted from ORefit, we assume as not having the outfit so ORefit is not applied
-        const bool hasBodyOutfit = !outfitBody ? false : !jsonParser.IsOutfitBlacklisted(*outfitBody);
-        const bool hasOutergarment = !outergarmentChest ? false : !jsonParser.IsOutfitBlacklisted(*outergarmentChest);
-        const bool hasUndergarment = !undergarmentChest ? false : !jsonParser.IsOutfitBlacklisted(*undergarmentChest);
+        auto isWearing = [&](const WornClothing::Slot slot) {
+            const auto* armor{a_wornClothing.slots[slot]};
+            return armor && !jsonParser.ClassifyOutfit(*armor).blacklisted;
+        };
 
         // Actor counts as naked if:
-        // he has no clothing in the slots defined above / they are blacklisted from ORefit
+        // he has no clothing in the body and chest slots / they are blacklisted from ORefit
         // if the items in the outfitsForceRefit key are not equipped
-        return !hasBodyOutfit && !hasOutergarment && !hasUndergarment &&
+        return !isWearing(WornClothing::kBody) && !isWearing(WornClothing::kOutergarmentChest) &&
+               !isWearing(WornClothing::kUndergarmentChest) &&
                !jsonParser.IsAnyForceRefitItemEquipped(a_actor, a_removingArmor, a_equippedArmor);
     }
 
     bool OBody::IsRemovingClothes(RE::Actor* a_actor, const bool a_removingArmor, const RE::TESForm* a_equippedArmor) {
-        using BipedObjectSlot = RE::BGSBipedObjectForm::BipedObjectSlot;
-        const auto* outfitBody{a_actor->GetWornArmor(BipedObjectSlot::kBody)};
-        const auto* outergarmentChest{a_actor->GetWornArmor(BipedObjectSlot::kModChestPrimary)};
-        const auto* undergarmentChest{a_actor->GetWornArmor(BipedObjectSlot::kModChestSecondary)};
-        const auto* outergarmentPelvis{a_actor->GetWornArmor(BipedObjectSlot::kModPelvisPrimary)};
-        const auto* undergarmentPelvis{a_actor->GetWornArmor(BipedObjectSlot::kModPelvisSecondary)};
-
-        bool isRemovingBody{false};
-        bool isRemovingOuterGarmentChest{false};
-        bool isRemovingUnderGarmentChest{false};
-        bool isRemovingOuterGarmentPelvis{false};
-        bool isRemovingUnderGarmentPelvis{false};
-
-        // When the TES EquipEvent is sent, the inventory isn't updated yet
-        // So we have to check if any of these armors is being removed...
-        if (a_removingArmor) {
-            if (outfitBody == a_equippedArmor) {
-                isRemovingBody = true;
-            } else if (outergarmentChest == a_equippedArmor) {
-                isRemovingOuterGarmentChest = true;
-            } else if (undergarmentChest == a_equippedArmor) {
-                isRemovingUnderGarmentChest = true;
-            } else if (outergarmentPelvis == a_equippedArmor) {
-                isRemovingOuterGarmentPelvis = true;
-            } else if (undergarmentPelvis == a_equippedArmor) {
-                isRemovingUnderGarmentPelvis = true;
-            }
-        }
-
-        return isRemovingBody || isRemovingOuterGarmentChest || isRemovingUnderGarmentChest ||
-               isRemovingOuterGarmentPelvis || isRemovingUnderGarmentPelvis;
+        return GetWornClothing(a_actor, a_removingArmor, a_equippedArmor).removingClothes;
     }
 
     bool OBody::IsFemale(RE::Actor* a_actor) { return a_actor->GetActorBase()->GetSex() == RE::SEX::kFemale; }
 
-    bool OBody::IsProcessed(RE::Actor* a_actor) const {
-        return morphInterface->HasBodyMorph(a_actor, distributionKey.c_str(), "OBody");
-    }
+    bool OBody::IsProcessed(RE::Actor* a_actor) const { return GetMorphFlags(a_actor).isProcessed; }
 
-    bool OBody::IsBlacklisted(RE::Actor* a_actor) const {
-        return morphInterface->HasBodyMorph(a_actor, "obody_blacklisted", "OBody");
-    }
-
-    PresetManager::SliderSet OBody::GenerateRandomNippleSliders() {
-        PresetManager::SliderSet set;
-
-        if (stl::chance(15))
-            AddSliderToSet(set, Slider{"AreolaSize", stl::random(-1.0f, 0.0f)});
-        else
-            AddSliderToSet(set, Slider{"AreolaSize", stl::random(0.0f, 1.0f)});
-
-        if (stl::chance(75)) AddSliderToSet(set, Slider{"AreolaPull_v2", stl::random(-0.25f, 1.0f)});
-
-        if (stl::chance(15))
-            AddSliderToSet(set, Slider{"NippleLength", stl::random(0.2f, 0.3f)});
-        else
-            AddSliderToSet(set, Slider{"NippleLength", stl::random(0.0f, 0.1f)});
+    bool OBody::IsBlacklisted(RE::Actor* a_actor) const { return GetMorphFlags(a_actor).isBlacklisted; }
 
-        AddSliderToSet(set, Slider{"NippleManga", stl::random(-0.3f, 0.8f)});
+    MorphFlags OBody::GetMorphFlags(RE::Actor* a_actor) const {
+        MorphFlags flags;
+        bool flagsAreKnown{false};
 
-        if (stl::chance(25)) AddSliderToSet(set, Slider{"NipplePerkManga", stl::random(-0.3f, 1.2f)});
+        ActorTracker::Registry::GetInstance().stateForActor.cvisit(a_actor->formID, [&](const auto& entry) {
+            const auto& state{entry.second};
+            flagsAreKnown = state.morphFlagsAreKnown;
+            flags = {static_cast<bool>(state.isProcessed), static_cast<bool>(state.isBlacklisted),
+                     static_cast<bool>(state.isClotheActive)};
+        });
 
-        if (stl::chance(15)) AddSliderToSet(set, Slider{"NipBGone", stl::random(0.6f, 1.0f)});
+        if (flagsAreKnown) return flags;
 
-        AddSliderToSet(set, Slider{"NippleSize", stl::random(-0.5f, 0.3f)});
-        AddSliderToSet(set, Slider{"NippleDip", stl::random(0.0f, 1.0f)});
-        AddSliderToSet(set, Slider{"NippleCrease_v2", stl::random(-0.4f, 1.0f)});
-
-        if (stl::chance(6)) AddSliderToSet(set, Slider{"NipplePuffy_v2", stl::random(0.4f, 0.7f)});
-
-        if (stl::chance(35)) AddSliderToSet(set, Slider{"NippleThicc_v2", stl::random(0.0f, 0.9f)});
-
-        if (stl::chance(2)) {
-            if (stl::chance(50))
-                AddSliderToSet(set, Slider{"NippleInvert_v2", 1.0f});
-            else
-                AddSliderToSet(set, Slider{"NippleInvert_v2", stl::random(0.65f, 0.8f)});
-        }
+        flags = QueryMorphFlags(a_actor);
+        SetMorphFlags(a_actor, flags);
 
-        return set;
+        return flags;
     }
 
-    PresetManager::SliderSet OBody::GenerateRandomGenitalSliders() {
-        PresetManager::SliderSet set;
-
-        if (stl::chance(20)) {
-            // innie
-            AddSliderToSet(set, Slider{"Innieoutie", stl::random(0.95f, 1.1f)});
+    MorphFlags OBody::QueryMorphFlags(RE::Actor* a_actor) const {
+        return {morphInterface->HasBodyMorph(a_actor, distributionKey.c_str(), "OBody"),
+                morphInterface->HasBodyMorph(a_actor, "obody_blacklisted", "OBody"),
+                morphInterface->HasBodyMorphKey(a_actor, "OClothe")};
+    }
 
-            if (stl::chance(50)) AddSliderToSet(set, Slider{"Labiapuffyness", stl::random(0.75f, 1.25f)});
+    void OBody::SetMorphFlags(RE::Actor* a_actor, const MorphFlags& a_flags) {
+        auto setFlags = [&](ActorTracker::ActorState& state) {
+            state.morphFlagsAreKnown = true;
+            state.isProcessed = a_flags.isProcessed;
+            state.isBlacklisted = a_flags.isBlacklisted;
+            state.isClotheActive = a_flags.isClotheActive;
+        };
 
-            if (stl::chance(40)) AddSliderToSet(set, Slider{"LabiaMorePuffyness_v2", stl::random(0.0f, 1.0f)});
+        ActorTracker::ActorState fallbackActorState{};
+        setFlags(fallbackActorState);
 
-            AddSliderToSet(set, Slider{"Labiaprotrude", stl::random(0.0f, 0.5f)});
-            AddSliderToSet(set, Slider{"Labiaprotrude2", stl::random(0.0f, 0.1f)});
-            AddSliderToSet(set, Slider{"Labiaprotrudeback", stl::random(0.0f, 0.1f)});
-            AddSliderToSet(set, Slider{"Labiaspread", 0.0F});
-            AddSliderToSet(set, Slider{"LabiaCrumpled_v2", stl::random(0.0f, 0.3f)});
-            AddSliderToSet(set, Slider{"LabiaBulgogi_v2", 0.0F});
-            AddSliderToSet(set, Slider{"LabiaNeat_v2", 0.0F});
-            AddSliderToSet(set, Slider{"VaginaHole", stl::random(-0.2f, 0.05f)});
-            AddSliderToSet(set, Slider{"Clit", stl::random(-0.4f, 0.25f)});
-        } else if (stl::chance(75)) {
-            // average
-            AddSliderToSet(set, Slider{"Innieoutie", stl::random(0.4f, 0.75f)});
+        auto& registry{ActorTracker::Registry::GetInstance()};
+        registry.stateForActor.emplace_or_visit(a_actor->formID, fallbackActorState,
+                                                [&](auto& entry) { setFlags(entry.second); });
+    }
 
-            if (stl::chance(40)) AddSliderToSet(set, Slider{"Labiapuffyness", stl::random(0.5f, 1.0f)});
+    void OBody::ForgetMorphFlags() {
+        ActorTracker::Registry::GetInstance().stateForActor.visit_all(
+            [](auto& entry) { entry.second.morphFlagsAreKnown = false; });
+    }
 
-            if (stl::chance(30)) AddSliderToSet(set, Slider{"LabiaMorePuffyness_v2", stl::random(0.0f, 0.75f)});
+    void OBody::ApplyRandomSliders(MorphBatch& a_batch, const std::span<const RandomSliders::Rule> a_rules,
+                                   const char* a_key) {
+        RandomSliders::Roll(a_rules,
+                            [&](const char* a_name, const float a_value) { a_batch.Set(a_name, a_key, a_value); });
+    }
 
-            AddSliderToSet(set, Slider{"Labiaprotrude", stl::random(0.0f, 0.5f)});
-            AddSliderToSet(set, Slider{"Labiaprotrude2", stl::random(0.0f, 0.75f)});
-            AddSliderToSet(set, Slider{"Labiaprotrudeback", stl::random(0.0f, 1.0f)});
+    ORefit::Baseline OBody::DeriveORefitBaseline(const MorphBatch& a_batch) {
+        return DeriveBaseline([&](const char* a_morph) { return a_batch.Get(a_morph, "OBody"); });
+    }
 
-            if (stl::chance(50)) {
-                AddSliderToSet(set, Slider{"Labiaspread", stl::random(0.0f, 1.0f)});
-                AddSliderToSet(set, Slider{"LabiaCrumpled_v2", stl::random(0.0f, 0.7f)});
+    ORefit::Baseline OBody::GetORefitBaseline(RE::Actor* a_actor) const {
+        auto& registry{ActorTracker::Registry::GetInstance()};
 
-                if (stl::chance(60)) AddSliderToSet(set, Slider{"LabiaBulgogi_v2", stl::random(0.0f, 0.1f)});
-            } else {
-                AddSliderToSet(set, Slider{"Labiaspread", 0.0F});
-                AddSliderToSet(set, Slider{"LabiaCrumpled_v2", stl::random(0.0f, 0.2f)});
+        ORefit::Baseline baseline;
+        if (registry.oRefitBaselineForActor.cvisit(a_actor->formID,
+                                                    [&](const auto& entry) { baseline = entry.second; })) {
+            return baseline;
+        }
 
-                if (stl::chance(45)) AddSliderToSet(set, Slider{"LabiaBulgogi_v2", stl::random(0.0f, 0.3f)});
-            }
+        // The actor's body was generated in an earlier session, or by someone other than us.
+        baseline = DeriveBaseline([&](const char* a_morph) { return GetMorph(a_actor, a_morph); });
+        registry.oRefitBaselineForActor.emplace(a_actor->formID, baseline);
 
-            AddSliderToSet(set, Slider{"LabiaNeat_v2", 0.0F});
-            AddSliderToSet(set, Slider{"VaginaHole", stl::random(-0.2f, 0.40f)});
-            AddSliderToSet(set, Slider{"Clit", stl::random(-0.2f, 0.25f)});
-        } else {
-            // outie
-            AddSliderToSet(set, Slider{"Innieoutie", stl::random(-0.25f, 0.30f)});
-
-            if (stl::chance(30)) AddSliderToSet(set, Slider{"Labiapuffyness", stl::random(0.20f, 0.50f)});
-
-            if (stl::chance(10)) AddSliderToSet(set, Slider{"LabiaMorePuffyness_v2", stl::random(0.0f, 0.35f)});
-
-            AddSliderToSet(set, Slider{"Labiaprotrude", stl::random(0.0f, 1.0f)});
-            AddSliderToSet(set, Slider{"Labiaprotrude2", stl::random(0.0f, 1.0f)});
-            AddSliderToSet(set, Slider{"Labiaprotrudeback", stl::random(0.0f, 1.0f)});
-            AddSliderToSet(set, Slider{"Labiaspread", stl::random(0.0f, 1.0f)});
-            AddSliderToSet(set, Slider{"LabiaCrumpled_v2", stl::random(0.0f, 1.0f)});
-            AddSliderToSet(set, Slider{"LabiaBulgogi_v2", stl::random(0.0f, 1.0f)});
-
-            if (stl::chance(40)) AddSliderToSet(set, Slider{"LabiaNeat_v2", stl::random(0.0f, 0.25f)});
-
-            AddSliderToSet(set, Slider{"VaginaHole", stl::random(0.0f, 1.0f)});
-            AddSliderToSet(set, Slider{"Clit", stl::random(-0.4f, 0.25f)});
-        }
-
-        AddSliderToSet(set, Slider{"Vaginasize", stl::random(0.0f, 1.0f)});
-        AddSliderToSet(set, Slider{"ClitSwell_v2", stl::random(-0.3f, 1.1f)});
-        AddSliderToSet(set, Slider{"Cutepuffyness", stl::random(0.0f, 1.0f)});
-        AddSliderToSet(set, Slider{"LabiaTightUp", stl::random(0.0f, 1.0f)});
-
-        if (stl::chance(60))
-            AddSliderToSet(set, Slider{"CBPC", stl::random(-0.25f, 0.25f)});
-        else
-            AddSliderToSet(set, Slider{"CBPC", stl::random(0.6f, 1.0f)});
-
-        AddSliderToSet(set, Slider{"AnalPosition_v2", stl::random(0.0f, 1.0f)});
-        AddSliderToSet(set, Slider{"AnalTexPos_v2", stl::random(0.0f, 1.0f)});
-        AddSliderToSet(set, Slider{"AnalTexPosRe_v2", stl::random(0.0f, 1.0f)});
-        AddSliderToSet(set, Slider{"AnalLoose_v2", -0.1F});
-
-        return set;
-    }
-
-    PresetManager::SliderSet OBody::GenerateClotheSliders(RE::Actor* a_actor) const {
-        PresetManager::SliderSet set;
-        // breasts
-        // make area on sides behind breasts not sink in
-        AddSliderToSet(set, DeriveSlider(a_actor, "BreastSideShape", 0.0F));
-        // make area under breasts not sink in
-        AddSliderToSet(set, DeriveSlider(a_actor, "BreastUnderDepth", 0.0F));
-        // push breasts together
-        AddSliderToSet(set, DeriveSlider(a_actor, "BreastCleavage", 1.0F));
-        // push up smaller breasts more
-        AddSliderToSet(set, Slider{"BreastGravity2", -0.1F, -0.05F});
-        // Make top of breast rise higher
-        AddSliderToSet(set, Slider{"BreastTopSlope", -0.2F, -0.35F});
-        // push breasts together
-        AddSliderToSet(set, Slider{"BreastsTogether", 0.3F, 0.35F});
-        // push breasts up
-        // AddSliderToSet(set, Slider{ "PushUp", 0.6f, 0.4f });
-        // Shrink breasts slightly
-        AddSliderToSet(set, Slider{"Breasts", -0.05F});
-        // Move breasts up on body slightly
-        AddSliderToSet(set, Slider{"BreastHeight", 0.15F});
-
-        // butt
-        // remove butt impressions
-        AddSliderToSet(set, DeriveSlider(a_actor, "ButtDimples", 0.0F));
-        AddSliderToSet(set, DeriveSlider(a_actor, "ButtUnderFold", 0.0F));
-        // shrink ass slightly
-        AddSliderToSet(set, Slider{"AppleCheeks", -0.05F});
-        AddSliderToSet(set, Slider{"Butt", -0.05F});
-
-        // Torso
-        // remove definition on clavical bone
-        AddSliderToSet(set, DeriveSlider(a_actor, "Clavicle_v2", 0.0F));
-        // Push out navel
-        AddSliderToSet(set, DeriveSlider(a_actor, "NavelEven", 1.0F));
-
-        // hip
-        // remove defintion on hip bone
-        AddSliderToSet(set, DeriveSlider(a_actor, "HipCarved", 0.0F));
-
-        if (setNippleSlidersRefitEnabled) {
-            // nipple
-            // sublte change to tip shape
-            AddSliderToSet(set, DeriveSlider(a_actor, "NippleDip", 0.0F));
-            AddSliderToSet(set, DeriveSlider(a_actor, "NippleTip", 0.0F));
-            // flatten areola
-            AddSliderToSet(set, DeriveSlider(a_actor, "NipplePuffy_v2", 0.0F));
-            // shrink areola
-            AddSliderToSet(set, DeriveSlider(a_actor, "AreolaSize", -0.3F));
-            // flatten nipple
-            AddSliderToSet(set, DeriveSlider(a_actor, "NipBGone", 1.0F));
-            // AddSliderToSet(set, DeriveSlider(a_actor, "NippleManga", -0.75f));
-            //  push nipples together
-            AddSliderToSet(set, Slider{"NippleDistance", 0.05F, 0.08F});
-            // Lift large breasts up
-            AddSliderToSet(set, Slider{"NippleDown", 0.0F, -0.1F});
-            // Flatten nipple + areola
-            AddSliderToSet(set, DeriveSlider(a_actor, "NipplePerkManga", -0.25F));
-            // Flatten nipple
-            // AddSliderToSet(set, DeriveSlider(a_actor, "NipplePerkiness", 0.0f));
-        }
-
-        return set;
-    }
-
-    Slider OBody::DeriveSlider(RE::Actor* a_actor, const char* a_morph, float a_target) const {
-        return Slider{a_morph, a_target - GetMorph(a_actor, a_morph)};
+        return baseline;
     }
 
     bool OBody::BecomingReadyForPluginAPIUsage() {
@@ -726,8 +793,8 @@ namespace Body {
             return false;
         }
 
-        for (auto eventListener : readinessEventListeners) {
-            eventListener->OBodyIsBecomingReady();
+        for (const auto eventListeners{readinessEventListeners.Load()}; const auto& entry : *eventListeners) {
+            entry.listener->OBodyIsBecomingReady();
         }
 
         readyForPluginAPIUsage = true;
@@ -738,8 +805,8 @@ namespace Body {
     void OBody::ReadyForPluginAPIUsage() {
         std::lock_guard<std::recursive_mutex> lock(readinessListenerLock);
 
-        for (auto eventListener : readinessEventListeners) {
-            eventListener->OBodyIsReady();
+        for (const auto eventListeners{readinessEventListeners.Load()}; const auto& entry : *eventListeners) {
+            entry.listener->OBodyIsReady();
         }
     }
 
@@ -750,8 +817,8 @@ namespace Body {
             return false;
         }
 
-        for (auto eventListener : readinessEventListeners) {
-            eventListener->OBodyIsBecomingUnready();
+        for (const auto eventListeners{readinessEventListeners.Load()}; const auto& entry : *eventListeners) {
+            entry.listener->OBodyIsBecomingUnready();
         }
 
         return true;
@@ -762,15 +829,15 @@ namespace Body {
 
         readyForPluginAPIUsage = false;
 
-        for (auto eventListener : readinessEventListeners) {
-            eventListener->OBodyIsNoLongerReady();
+        for (const auto eventListeners{readinessEventListeners.Load()}; const auto& entry : *eventListeners) {
+            entry.listener->OBodyIsNoLongerReady();
         }
     }
 
     bool OBody::AttachEventListener(::OBody::API::IOBodyReadinessEventListener& eventListener) {
         std::lock_guard<std::recursive_mutex> lock(readinessListenerLock);
 
-        readinessEventListeners.push_back(&eventListener);
+        readinessEventListeners.Add(&eventListener);
 
         return true;
     }
@@ -778,28 +845,26 @@ namespace Body {
     bool OBody::DetachEventListener(::OBody::API::IOBodyReadinessEventListener& eventListener) {
         std::lock_guard<std::recursive_mutex> lock(readinessListenerLock);
 
-        return std::erase(readinessEventListeners, &eventListener) != 0;
+        return readinessEventListeners.Remove(&eventListener);
     }
 
     bool OBody::AttachEventListener(::OBody::API::IActorChangeEventListener& eventListener) {
-        std::lock_guard<std::recursive_mutex> lock(actorChangeListenerLock);
-
-        actorChangeEventListeners.push_back(&eventListener);
+        actorChangeEventListeners.Add(&eventListener);
 
         return true;
     }
 
-    bool OBody::DetachEventListener(::OBody::API::IActorChangeEventListener& eventListener) {
-        std::lock_guard<std::recursive_mutex> lock(actorChangeListenerLock);
+    bool OBody::SubscribeEventListener(::OBody::API::IActorChangeEventListener& eventListener,
+                                       const ActorChangeEventSubscription& subscription) {
+        return actorChangeEventListeners.AddOrReplace(&eventListener, subscription);
+    }
 
-        return std::erase(actorChangeEventListeners, &eventListener) != 0;
+    bool OBody::DetachEventListener(::OBody::API::IActorChangeEventListener& eventListener) {
+        return actorChangeEventListeners.Remove(&eventListener);
     }
 
     bool OBody::IsEventListenerAttached(::OBody::API::IActorChangeEventListener& eventListener) {
-        std::lock_guard<std::recursive_mutex> lock(actorChangeListenerLock);
-
-        return std::find(actorChangeEventListeners.begin(), actorChangeEventListeners.end(), &eventListener) !=
-               actorChangeEventListeners.end();
+        return actorChangeEventListeners.Contains(&eventListener);
     }
 
 }  // namespace Body
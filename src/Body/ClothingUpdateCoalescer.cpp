@@ -0,0 +1,47 @@
+#include "Body/ClothingUpdateCoalescer.h"
+
+#include "Body/Body.h"
+
+Body::ClothingUpdateCoalescer Body::ClothingUpdateCoalescer::instance;
+
+namespace Body {
+    ClothingUpdateCoalescer& ClothingUpdateCoalescer::GetInstance() { return instance; }
+
+    void ClothingUpdateCoalescer::Push(RE::Actor* a_actor, const Event::Flags a_flags,
+                                       const Event::Payload& a_payload) {
+        bool queueFlush;
+        {
+            std::lock_guard guard{lock};
+            pendingUpdates.insert_or_assign(a_actor->formID, PendingUpdate{a_actor->GetHandle(), a_flags, a_payload});
+
+            queueFlush = !flushIsQueued;
+            flushIsQueued = true;
+        }
+
+        if (queueFlush) SKSE::GetTaskInterface()->AddTask([this] { Flush(); });
+    }
+
+    void ClothingUpdateCoalescer::Flush() {
+        decltype(pendingUpdates) updates;
+        {
+            std::lock_guard guard{lock};
+            updates.swap(pendingUpdates);
+            flushIsQueued = false;
+        }
+
+        const auto& obody{OBody::GetInstance()};
+
+        for (const auto& [formID, update] : updates) {
+            // Actors that are no longer valid are dropped.
+            const auto actorPointer{update.actorHandle.get()};
+            if (!actorPointer) continue;
+
+            obody.SendActorChangeEvent<::OBody::API::ActorChangeEventActorClothingUpdate>(
+                actorPointer.get(), [&] { return std::make_pair(update.flags, update.payload); },
+                [](auto listener, auto actor, auto&& args) {
+                    listener->OnActorClothingUpdate(actor, args.first, args.second);
+                },
+                true);
+        }
+    }
+}  // namespace Body
@@ -1,6 +1,8 @@
 #include "Body/Event.h"
 
+#include "ActorTracker/ActorTracker.h"
 #include "Body/Body.h"
+#include "Body/GenerationQueue.h"
 #include "JSONParser/JSONParser.h"
 
 constinit Event::OBodyEventHandler Event::OBodyEventHandler::singleton;
@@ -10,6 +12,8 @@ void Event::OBodyEventHandler::Register() {
         events->AddEventSink<RE::TESInitScriptEvent>(&singleton);
         events->AddEventSink<RE::TESLoadGameEvent>(&singleton);
         events->AddEventSink<RE::TESEquipEvent>(&singleton);
+        events->AddEventSink<RE::TESObjectLoadedEvent>(&singleton);
+        events->AddEventSink<RE::TESFormDeleteEvent>(&singleton);
     }
 }
 
@@ -19,7 +23,12 @@ RE::BSEventNotifyControl Event::OBodyEventHandler::ProcessEvent(const RE::TESIni
 
     if (RE::Actor * actor{a_event->objectInitialized->As<RE::Actor>()};
         (actor != nullptr) && actor->HasKeywordString("ActorTypeNPC") && !actor->IsChild()) {
-        Body::OBody::GetInstance().GenerateActorBody(actor, nullptr);
+        if (auto& generationQueue{Body::GenerationQueue::GetInstance()};
+            generationQueue.enabled.load(std::memory_order_relaxed)) {
+            generationQueue.Enqueue(actor);
+        } else {
+            Body::OBody::GetInstance().GenerateActorBody(actor, nullptr);
+        }
     }
 
     return RE::BSEventNotifyControl::kContinue;
@@ -67,3 +76,22 @@ RE::BSEventNotifyControl Event::OBodyEventHandler::ProcessEvent(const RE::TESEqu
 
     return RE::BSEventNotifyControl::kContinue;
 }
+
+// An actor's ORefit baseline is only good for as long as their body is the one it was worked out from,
+// and the form-IDs of runtime-created actors are recycled once they're deleted, so we forget the baseline
+// when the actor goes: it's worked out again from their morphs, should they come back.
+RE::BSEventNotifyControl Event::OBodyEventHandler::ProcessEvent(const RE::TESObjectLoadedEvent* a_event,
+                                                                RE::BSTEventSource<RE::TESObjectLoadedEvent>*) {
+    if (a_event && !a_event->loaded) {
+        ActorTracker::Registry::GetInstance().oRefitBaselineForActor.erase(a_event->formID);
+    }
+
+    return RE::BSEventNotifyControl::kContinue;
+}
+
+RE::BSEventNotifyControl Event::OBodyEventHandler::ProcessEvent(const RE::TESFormDeleteEvent* a_event,
+                                                                RE::BSTEventSource<RE::TESFormDeleteEvent>*) {
+    if (a_event) ActorTracker::Registry::GetInstance().oRefitBaselineForActor.erase(a_event->formID);
+
+    return RE::BSEventNotifyControl::kContinue;
+}
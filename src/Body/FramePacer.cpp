@@ -0,0 +1,53 @@
+#include "Body/FramePacer.h"
+
+namespace Body {
+    // Roughly a frame, at 60 FPS.
+    constexpr auto DrainInterval{std::chrono::milliseconds(16)};
+
+    FramePacer::FramePacer(Drain a_drain) : state(std::make_shared<State>()) { state->drain = std::move(a_drain); }
+
+    FramePacer::~FramePacer() { stopSource.request_stop(); }
+
+    void FramePacer::Notify() {
+        std::call_once(pacerStarted, [this] {
+            std::thread([state = state, stopToken = stopSource.get_token()] { Pace(state, stopToken); }).detach();
+        });
+
+        {
+            std::lock_guard guard{state->lock};
+            state->workIsPending = true;
+        }
+
+        state->workAvailable.notify_one();
+    }
+
+    void FramePacer::Pace(const std::shared_ptr<State>& a_state, const std::stop_token& stopToken) {
+        while (!stopToken.stop_requested()) {
+            {
+                std::unique_lock uniqueLock{a_state->lock};
+                if (!a_state->workAvailable.wait(uniqueLock, stopToken, [&] {
+                        return a_state->workIsPending && !a_state->drainIsQueued;
+                    })) {
+                    return;
+                }
+
+                a_state->workIsPending = false;
+                a_state->drainIsQueued = true;
+            }
+
+            SKSE::GetTaskInterface()->AddTask([a_state] {
+                const bool workIsLeft{a_state->drain()};
+                {
+                    std::lock_guard guard{a_state->lock};
+                    a_state->drainIsQueued = false;
+                    // Work may have been pushed while the drain ran, which we mustn't forget about.
+                    a_state->workIsPending |= workIsLeft;
+                }
+
+                a_state->workAvailable.notify_one();
+            });
+
+            std::this_thread::sleep_for(DrainInterval);
+        }
+    }
+}  // namespace Body
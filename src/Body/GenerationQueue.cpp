@@ -0,0 +1,65 @@
+#include "Body/GenerationQueue.h"
+
+#include "Body/Body.h"
+
+Body::GenerationQueue Body::GenerationQueue::instance;
+
+namespace Body {
+    GenerationQueue& GenerationQueue::GetInstance() { return instance; }
+
+    void GenerationQueue::Enqueue(RE::Actor* a_actor) {
+        const auto actorHandle{a_actor->GetHandle()};
+        {
+            std::lock_guard guard{lock};
+            if (!pendingActorHandles.insert(actorHandle.native_handle()).second) return;
+        }
+
+        Push({actorHandle, {}});
+    }
+
+    void GenerationQueue::Enqueue(const RE::ActorHandle a_actorHandle, Job a_job) {
+        Push({a_actorHandle, std::move(a_job)});
+    }
+
+    void GenerationQueue::Push(PendingGeneration&& a_pendingGeneration) {
+        {
+            std::lock_guard guard{lock};
+            pendingGenerations.push_back(std::move(a_pendingGeneration));
+        }
+
+        pacer.Notify();
+    }
+
+    bool GenerationQueue::GenerateBatch() {
+        const auto start{std::chrono::steady_clock::now()};
+        const std::chrono::microseconds budget{budgetPerFrameInMicroseconds.load(std::memory_order_relaxed)};
+
+        const auto& obody{OBody::GetInstance()};
+
+        for (bool first = true; first || std::chrono::steady_clock::now() - start < budget; first = false) {
+            PendingGeneration pendingGeneration;
+            {
+                std::lock_guard guard{lock};
+                if (pendingGenerations.empty()) break;
+
+                pendingGeneration = std::move(pendingGenerations.front());
+                pendingGenerations.pop_front();
+                if (!pendingGeneration.job) pendingActorHandles.erase(pendingGeneration.actorHandle.native_handle());
+            }
+
+            // Actors that are no longer valid, or that were unloaded while they waited, are dropped from the queue.
+            const auto actor{pendingGeneration.actorHandle.get()};
+            RE::Actor* loadedActor{actor && actor->Is3DLoaded() ? actor.get() : nullptr};
+
+            if (pendingGeneration.job) {
+                pendingGeneration.job(loadedActor);
+            } else if (loadedActor) {
+                obody.GenerateActorBody(loadedActor, nullptr);
+            }
+        }
+
+        // Whatever's left over goes in the next batch.
+        std::lock_guard guard{lock};
+        return !pendingGenerations.empty();
+    }
+}  // namespace Body
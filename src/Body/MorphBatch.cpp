@@ -0,0 +1,105 @@
+#include "Body/MorphBatch.h"
+
+#include "Instrumentation/Instrumentation.h"
+
+namespace Body {
+    MorphBatch::MorphBatch(RE::Actor* a_actor, SKEE::IBodyMorphInterface* a_morphInterface)
+        : actor(a_actor), morphInterface(a_morphInterface) {}
+
+    std::string MorphBatch::IndexKey(const std::string_view a_morphName, const std::string_view a_key) {
+        std::string indexKey;
+        indexKey.reserve(a_key.size() + 1 + a_morphName.size());
+        indexKey.append(a_key).push_back('\0');
+        indexKey.append(a_morphName);
+        return indexKey;
+    }
+
+    bool MorphBatch::IsKeyCleared(const std::string_view a_key) const {
+        return clearsAllMorphs || std::ranges::any_of(clearedKeys, [&](const char* key) { return a_key == key; });
+    }
+
+    void MorphBatch::ClearKey(const char* a_key) {
+        if (!IsKeyCleared(a_key)) clearedKeys.push_back(a_key);
+    }
+
+    void MorphBatch::ClearAll() { clearsAllMorphs = true; }
+
+    void MorphBatch::Set(const std::string_view a_morphName, const char* a_key, const float a_value) {
+        const auto [itr, inserted]{
+            entryIndexes.try_emplace(IndexKey(a_morphName, a_key), static_cast<uint32_t>(entries.size()))};
+
+        if (inserted) {
+            entries.emplace_back(std::string{a_morphName}, a_key, a_value);
+        } else {
+            entries[itr->second].value = a_value;
+        }
+    }
+
+    float MorphBatch::Get(const std::string_view a_morphName, const char* a_key) const {
+        if (const auto itr{entryIndexes.find(IndexKey(a_morphName, a_key))}; itr != entryIndexes.end()) {
+            return entries[itr->second].value;
+        }
+
+        if (IsKeyCleared(a_key)) return 0.0F;
+
+        return morphInterface->GetMorph(actor, std::string{a_morphName}.c_str(), a_key);
+    }
+
+    void MorphBatch::ClearStaleMorphs() {
+        struct StaleMorph {
+            std::string morphName;
+            const char* key;
+        };
+
+        // We can't be clearing morphs while RaceMenu is visiting them, so we note them down and clear them after.
+        class Visitor : public SKEE::IBodyMorphInterface::MorphValueVisitor {
+        public:
+            explicit Visitor(MorphBatch& a_batch) : batch(a_batch) {}
+
+            void Visit(RE::TESObjectREFR*, const char* a_morphName, const char* a_key, const float a_value) override {
+                if (!a_morphName || !a_key) return;
+
+                if (const auto itr{batch.entryIndexes.find(IndexKey(a_morphName, a_key))};
+                    itr != batch.entryIndexes.end()) {
+                    auto& entry{batch.entries[itr->second]};
+                    entry.upToDate = entry.value == a_value;
+                    return;
+                }
+
+                const auto clearedKey{std::ranges::find_if(
+                    batch.clearedKeys, [&](const char* key) { return std::string_view{a_key} == key; })};
+
+                if (clearedKey != batch.clearedKeys.end()) staleMorphs.emplace_back(a_morphName, *clearedKey);
+            }
+
+            MorphBatch& batch;
+            std::vector<StaleMorph> staleMorphs;
+        };
+
+        Visitor visitor{*this};
+        morphInterface->VisitMorphValues(actor, visitor);
+
+        for (const auto& [morphName, key] : visitor.staleMorphs) {
+            morphInterface->ClearMorph(actor, morphName.c_str(), key);
+        }
+    }
+
+    void MorphBatch::Flush() {
+        Instrumentation::ScopedTimer const timer{Instrumentation::Stage::SKEECalls};
+
+        if (clearsAllMorphs) {
+            morphInterface->ClearMorphs(actor);
+        } else {
+            ClearStaleMorphs();
+        }
+
+        for (const auto& entry : entries) {
+            if (!entry.upToDate) morphInterface->SetMorph(actor, entry.morphName.c_str(), entry.key, entry.value);
+        }
+
+        entries.clear();
+        entryIndexes.clear();
+        clearedKeys.clear();
+        clearsAllMorphs = false;
+    }
+}  // namespace Body
@@ -0,0 +1,71 @@
+#include "Body/MorphScheduler.h"
+
+#include "Body/Body.h"
+
+Body::MorphScheduler Body::MorphScheduler::instance;
+
+namespace Body {
+    MorphScheduler& MorphScheduler::GetInstance() { return instance; }
+
+    void MorphScheduler::Schedule(RE::Actor* a_actor, const bool applyProcessedMorph) {
+        const auto actorHandle{a_actor->GetHandle()};
+        {
+            std::lock_guard guard{lock};
+            pendingUpdates.insert_or_assign(actorHandle.native_handle(),
+                                            PendingUpdate{actorHandle, applyProcessedMorph});
+        }
+
+        pacer.Notify();
+    }
+
+    bool MorphScheduler::ApplyBatch() {
+        struct Candidate {
+            float distanceToPlayer;
+            RE::NiPointer<RE::Actor> actor;
+            PendingUpdate update;
+        };
+
+        std::vector<Candidate> batch;
+        bool updatesAreLeft{false};
+        {
+            std::lock_guard guard{lock};
+
+            const auto* player{RE::PlayerCharacter::GetSingleton()};
+            const auto playerPosition{player ? player->GetPosition() : RE::NiPoint3{}};
+
+            std::vector<Candidate> candidates;
+            candidates.reserve(pendingUpdates.size());
+            for (const auto& update : pendingUpdates | std::views::values) {
+                // Actors that are no longer valid are dropped from the queue.
+                if (auto actor{update.actorHandle.get()}) {
+                    const float distanceToPlayer{actor->GetPosition().GetSquaredDistance(playerPosition)};
+                    candidates.emplace_back(distanceToPlayer, std::move(actor), update);
+                }
+            }
+
+            const std::size_t batchSize{
+                std::min<std::size_t>(std::max(morphUpdatesPerFrame.load(std::memory_order_relaxed), 1u),
+                                      candidates.size())};
+            std::ranges::partial_sort(candidates, candidates.begin() + static_cast<std::ptrdiff_t>(batchSize), {},
+                                      &Candidate::distanceToPlayer);
+
+            pendingUpdates.clear();
+            for (std::size_t i = batchSize; i < candidates.size(); ++i) {
+                const auto& update{candidates[i].update};
+                pendingUpdates.emplace(update.actorHandle.native_handle(), update);
+            }
+
+            candidates.erase(candidates.begin() + static_cast<std::ptrdiff_t>(batchSize), candidates.end());
+            batch = std::move(candidates);
+            // Whatever's left over goes in the next batch.
+            updatesAreLeft = !pendingUpdates.empty();
+        }
+
+        const auto& obody{OBody::GetInstance()};
+        for (const auto& candidate : batch) {
+            obody.ApplyScheduledMorphs(candidate.actor.get(), candidate.update.applyProcessedMorph);
+        }
+
+        return updatesAreLeft;
+    }
+}  // namespace Body
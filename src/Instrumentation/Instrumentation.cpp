@@ -0,0 +1,95 @@
+#include "Instrumentation/Instrumentation.h"
+
+namespace Instrumentation {
+    namespace {
+        struct StageCounters {
+            std::atomic<uint64_t> count{0};
+            std::atomic<uint64_t> totalNanoseconds{0};
+            std::atomic<uint64_t> maxNanoseconds{0};
+            std::array<std::atomic<uint64_t>, HistogramBucketCount> histogram{};
+        };
+
+        std::array<StageCounters, StageCount> counters;
+
+        // clang-format off
+        constexpr std::array<const char*, StageCount> StageNames{
+            "DistributionDecision",
+            "SliderBuild",
+            "SKEECalls",
+            "EventDispatch",
+            "EquipClassification",
+            "CosaveRead",
+            "CosaveWrite",
+        };
+        // clang-format on
+    }  // namespace
+
+    const char* GetStageName(const Stage a_stage) { return StageNames[static_cast<std::size_t>(a_stage)]; }
+
+    void Record(const Stage a_stage, const std::chrono::nanoseconds a_duration) {
+        if (recordingPaused) return;
+
+        auto& stageCounters{counters[static_cast<std::size_t>(a_stage)]};
+        const auto nanoseconds{static_cast<uint64_t>(std::max<int64_t>(a_duration.count(), 0))};
+
+        stageCounters.count.fetch_add(1, std::memory_order_relaxed);
+        stageCounters.totalNanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+
+        for (auto max{stageCounters.maxNanoseconds.load(std::memory_order_relaxed)};
+             nanoseconds > max &&
+             !stageCounters.maxNanoseconds.compare_exchange_weak(max, nanoseconds, std::memory_order_relaxed);) {
+        }
+
+        const auto bucket{std::min<std::size_t>(std::bit_width(nanoseconds / 1000), HistogramBucketCount - 1)};
+        stageCounters.histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    StageTimings GetTimings(const Stage a_stage) {
+        const auto& stageCounters{counters[static_cast<std::size_t>(a_stage)]};
+
+        StageTimings timings;
+        timings.count = stageCounters.count.load(std::memory_order_relaxed);
+        timings.totalNanoseconds = stageCounters.totalNanoseconds.load(std::memory_order_relaxed);
+        timings.maxNanoseconds = stageCounters.maxNanoseconds.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < HistogramBucketCount; ++i) {
+            timings.histogram[i] = stageCounters.histogram[i].load(std::memory_order_relaxed);
+        }
+
+        return timings;
+    }
+
+    void Reset() {
+        for (auto& stageCounters : counters) {
+            stageCounters.count.store(0, std::memory_order_relaxed);
+            stageCounters.totalNanoseconds.store(0, std::memory_order_relaxed);
+            stageCounters.maxNanoseconds.store(0, std::memory_order_relaxed);
+            for (auto& bucket : stageCounters.histogram) bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void Dump(const spdlog::level::level_enum a_level) {
+        if (!spdlog::should_log(a_level)) return;
+
+        spdlog::log(a_level, "Stage timings:");
+
+        for (std::size_t i = 0; i < StageCount; ++i) {
+            const auto stage{static_cast<Stage>(i)};
+            const auto timings{GetTimings(stage)};
+            if (timings.count == 0) continue;
+
+            // The histogram is written out up to the last bucket that counted anything, to keep the lines short.
+            std::size_t bucketCount{HistogramBucketCount};
+            while (bucketCount > 0 && timings.histogram[bucketCount - 1] == 0) --bucketCount;
+
+            std::string histogram;
+            for (std::size_t bucket = 0; bucket < bucketCount; ++bucket) {
+                if (bucket != 0) histogram += ' ';
+                histogram += std::to_string(timings.histogram[bucket]);
+            }
+
+            spdlog::log(a_level, "\t{}: {} runs, {} us in total, {} us on average, {} us at most; histogram: [{}]",
+                        GetStageName(stage), timings.count, timings.totalNanoseconds / 1000,
+                        timings.totalNanoseconds / timings.count / 1000, timings.maxNanoseconds / 1000, histogram);
+        }
+    }
+}  // namespace Instrumentation
@@ -0,0 +1,62 @@
+#include "JSONParser/ConfigFile.h"
+#include "STL.h"
+
+namespace ConfigFile {
+    std::optional<std::string> Read(const char* a_path) {
+        const stl::FilePtrManager file{a_path};
+        if (file.error() != 0) return std::nullopt;
+
+        std::string contents;
+        char readBuffer[65536];
+        for (std::size_t read; (read = fread(readBuffer, 1, std::size(readBuffer), file.get())) != 0;) {
+            contents.append(readBuffer, read);
+        }
+
+        return contents;
+    }
+
+    rapidjson::Document& Parse(rapidjson::Document& a_document, const std::string_view a_json) {
+        rapidjson::MemoryStream bis(a_json.data(), a_json.size());
+        rapidjson::AutoUTFInputStream<unsigned, rapidjson::MemoryStream> eis(bis);
+        return a_document.ParseStream<0, rapidjson::AutoUTF<unsigned>>(eis);
+    }
+
+    bool Validate(const rapidjson::Document& a_config, const std::string_view a_schemaJson) {
+        [[maybe_unused]] stl::timeit const t;
+
+        rapidjson::Document sd;
+        if (Parse(sd, a_schemaJson).HasParseError()) {
+            logger::info("Error(offset {}): {}", sd.GetErrorOffset(), rapidjson::GetParseError_En(sd.GetParseError()));
+            logger::error("Unable to parse OBody_presetDistributionConfig_schema.json");
+            return false;
+        }
+
+        rapidjson::SchemaDocument schema(sd);
+        if (rapidjson::SchemaValidator validator(schema); !a_config.Accept(validator)) {
+            rapidjson::StringBuffer sb;
+            const auto invalidSchemaPointer = validator.GetInvalidSchemaPointer();
+            invalidSchemaPointer.StringifyUriFragment(sb);
+            logger::error("Invalid schema: {}", sb.GetString());
+            logger::error("Invalid keyword: {}", validator.GetInvalidSchemaKeyword());
+            sb.Clear();
+            const auto invalidDocumentPointer = validator.GetInvalidDocumentPointer();
+            invalidDocumentPointer.StringifyUriFragment(sb);
+            logger::error("Invalid document: {}", sb.GetString());
+            sb.Clear();
+            if (auto* err_value_ptr = invalidDocumentPointer.Get(a_config)) {
+                rapidjson::PrettyWriter writer(sb);
+                err_value_ptr->Accept(writer);
+                logger::error("Error at: {}", sb.GetString());
+                sb.Clear();
+            }
+            if (auto* err_values_schema_pointer = invalidSchemaPointer.Get(sd)) {
+                rapidjson::PrettyWriter writer(sb);
+                err_values_schema_pointer->Accept(writer);
+                logger::error("Schema Definition of Error: {}", sb.GetString());
+            }
+            return false;
+        }
+
+        return true;
+    }
+}  // namespace ConfigFile
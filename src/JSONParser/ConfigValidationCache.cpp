@@ -0,0 +1,48 @@
+#include "JSONParser/ConfigValidationCache.h"
+
+namespace ConfigValidationCache {
+    uint64_t ComputeFingerprint(const std::string_view a_config, const std::string_view a_schema) {
+        stl::Fingerprinter fingerprint;
+        fingerprint.Add(FormatVersion);
+
+        fingerprint.Add(a_config.size());
+        fingerprint.Add(a_config.data(), a_config.size());
+
+        fingerprint.Add(a_schema.size());
+        fingerprint.Add(a_schema.data(), a_schema.size());
+
+        return fingerprint.hash;
+    }
+
+    bool IsValidated(const uint64_t a_fingerprint) {
+        const stl::FilePtrManager file{CachePath};
+        if (!file.get()) return false;
+
+        HeaderV1 header{};
+        if (fread(&header, sizeof(header), 1, file.get()) != 1) return false;
+
+        return header.magic == Magic && header.version == FormatVersion && header.fingerprint == a_fingerprint;
+    }
+
+    void SaveValidated(const uint64_t a_fingerprint) {
+        const HeaderV1 header{Magic, FormatVersion, a_fingerprint};
+
+        // We write to a temporary file first, so that a crash mid-write never leaves behind a corrupt cache.
+        const std::string temporaryPath{std::string{CachePath} + ".tmp"};
+        bool written;
+        {
+            const stl::FilePtrManager file{temporaryPath.c_str(), "wb"};
+            if (!file.get()) return;
+
+            written = fwrite(&header, sizeof(header), 1, file.get()) == 1;
+        }
+
+        std::error_code ec;
+        if (written) fs::rename(temporaryPath, CachePath, ec);
+
+        if (!written || ec) {
+            logger::warn("Failed to write the config validation cache.");
+            fs::remove(temporaryPath, ec);
+        }
+    }
+}  // namespace ConfigValidationCache
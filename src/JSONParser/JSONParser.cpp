@@ -1,4 +1,5 @@
 #include "JSONParser/JSONParser.h"
+#include "Instrumentation/Instrumentation.h"
 #include "STL.h"
 
 Parser::JSONParser Parser::JSONParser::instance;
@@ -12,8 +13,8 @@ namespace Parser {
         return form->sourceFiles.array;  // Check if the source files array exists
     }
 
-    std::string GetNthFormLocationName(const RE::TESForm* form, const uint32_t n) {
-        std::string formName;
+    std::string_view GetNthFormLocationName(const RE::TESForm* form, const uint32_t n) {
+        std::string_view formName;
 
         if (GetHasSourceFileArray(form) && form->sourceFiles.array->size() > n) {
             RE::TESFile** sourceFiles = form->sourceFiles.array->data();
@@ -31,58 +32,21 @@ namespace Parser {
         return formName;
     }
 
-    bool IsActorInForm(const RE::TESNPC* form, const std::string_view target) {
-        if (GetHasSourceFileArray(form) && !form->sourceFiles.array->empty()) {
-            RE::TESFile** sourceFiles{form->sourceFiles.array->data()};
-
-            for (int i{}; i < form->sourceFiles.array->size(); i++) {
-                if (sourceFiles[i]->fileName == target) {
-                    return true;
-                }
-            }
-        }
-
-        return false;
-    }
-
     bool JSONParser::IsActorInBlacklistedCharacterCategorySet(const uint32_t formID) const {
-        for (const auto a_formID : blacklistedCharacterCategorySet | std::views::transform(&categorizedList::formID)) {
-            if (a_formID == formID) {
-                return true;
-            }
-        }
-
-        return false;
+        return blacklistedCharacterCategorySet.contains(formID);
     }
 
-    bool JSONParser::IsOutfitInBlacklistedOutfitCategorySet(const uint32_t formID) {
-        for (const auto a_formID : blacklistedOutfitCategorySet | std::views::transform(&categorizedList::formID)) {
-            if (a_formID == formID) {
-                return true;
-            }
-        }
-
-        return false;
+    bool JSONParser::IsOutfitInBlacklistedOutfitCategorySet(const uint32_t formID) const {
+        return blacklistedOutfitCategorySet.contains(formID);
     }
 
     bool JSONParser::IsOutfitInForceRefitCategorySet(const uint32_t formID) const {
-        for (const auto a_formID : forceRefitOutfitCategorySet | std::views::transform(&categorizedList::formID)) {
-            if (a_formID == formID) {
-                return true;
-            }
-        }
-
-        return false;
+        return forceRefitOutfitCategorySet.contains(formID);
     }
 
-    std::optional<categorizedList> JSONParser::GetNPCFromCategorySet(const uint32_t formID) const {
-        for (const categorizedList& character : characterCategorySet) {
-            if (character.formID == formID) {
-                return character;
-            }
-        }
-
-        return {};
+    const categorizedList* JSONParser::GetNPCFromCategorySet(const uint32_t formID) const {
+        const auto itr{characterCategorySet.find(formID)};
+        return itr != characterCategorySet.end() ? &itr->second : nullptr;
     }
 
     inline std::string DiscardFormDigits(const std::string_view formID, const RE::TESFile* mod) {
@@ -122,12 +86,13 @@ namespace Parser {
 
                     // We have to use this full-length ID in order to identify them.
                     auto ID = actorform->GetFormID();
-                    std::vector<std::string> bodyslidePresets(formValue.GetArray().Size());
+                    std::vector<std::string> bodyslidePresets;
+                    bodyslidePresets.reserve(formValue.GetArray().Size());
                     for (const auto& item : formValue.GetArray()) {
                         bodyslidePresets.emplace_back(item.GetString());
                     }
 
-                    characterCategorySet.emplace_back(owningMod.GetString(), ID, std::move(bodyslidePresets));
+                    characterCategorySet.try_emplace(ID, owningMod.GetString(), ID, std::move(bodyslidePresets));
                 }
                 ++itr;
             }
@@ -164,7 +129,7 @@ namespace Parser {
                     // We have to use this full-length ID in order to identify them.
                     auto ID = actorform->GetFormID();
 
-                    blacklistedCharacterCategorySet.emplace_back(plugin.GetString(), ID);
+                    blacklistedCharacterCategorySet.emplace(ID);
                 }
                 ++itr;
             }
@@ -203,7 +168,7 @@ namespace Parser {
                     // We have to use this full-length ID in order to identify them.
                     auto ID = outfitform->GetFormID();
 
-                    blacklistedOutfitCategorySet.emplace_back(plugin.GetString(), ID);
+                    blacklistedOutfitCategorySet.emplace(ID);
                 }
                 ++itr;
             }
@@ -240,7 +205,7 @@ namespace Parser {
                     // We have to use this full-length ID in order to identify them.
                     auto ID = outfitform->GetFormID();
 
-                    forceRefitOutfitCategorySet.emplace_back(plugin.GetString(), ID);
+                    forceRefitOutfitCategorySet.emplace(ID);
                 }
                 ++itr;
             }
@@ -522,6 +487,13 @@ namespace Parser {
 
     void JSONParser::ProcessJSONCategories() {
         [[maybe_unused]] stl::timeit const t;
+
+        // The config may have been reloaded since the categories were last processed.
+        blacklistedCharacterCategorySet.clear();
+        characterCategorySet.clear();
+        blacklistedOutfitCategorySet.clear();
+        forceRefitOutfitCategorySet.clear();
+
         logger::info(TitleFormatSpecifier, "Starting: Removing Not-Loaded Items");
         ProcessNPCsFormIDBlacklist();
         ProcessNPCsFormID();
@@ -529,198 +501,422 @@ namespace Parser {
         ProcessOutfitsForceRefitFormIDBlacklist();
         FilterOutNonLoaded();
         logger::info(TitleFormatSpecifier, "Finished: Removing Not-Loaded Items");
-        rapidjson::StringBuffer buffer;
-        rapidjson::PrettyWriter writer(buffer);
-        presetDistributionConfig.Accept(writer);
 
-        logger::info("After Filtering: \n{}", buffer.GetString());
+        // Printing the whole config is only for debugging, and is costly for the larger configs.
+        if (spdlog::should_log(spdlog::level::debug)) {
+            rapidjson::StringBuffer buffer;
+            rapidjson::PrettyWriter writer(buffer);
+            presetDistributionConfig.Accept(writer);
+
+            logger::debug("After Filtering: \n{}", buffer.GetString());
+        }
     }
 
-    bool JSONParser::IsStringInJsonConfigKey(const std::string_view a_value, const char* key) {
-        const auto obj{presetDistributionConfig.FindMember(key)};
-        if (obj == presetDistributionConfig.MemberEnd()) {
-            return false;
+    CompiledRules::PresetList ResolvePresetList(const rapidjson::Value& a_presetNames, const bool female) {
+        const auto& presetContainer{PresetManager::PresetContainer::GetInstance()};
+        CompiledRules::PresetList presets;
+
+        if (!a_presetNames.IsArray()) return presets;
+
+        presets.reserve(a_presetNames.Size());
+        for (const auto& presetName : a_presetNames.GetArray()) {
+            if (!presetName.IsString()) continue;
+
+            if (const auto* preset{presetContainer.FindPresetByName(presetName.GetString(), female)}) {
+                presets.push_back(preset);
+            }
         }
-        const auto& objValue = obj->value;
-        return std::find(objValue.Begin(), objValue.End(), a_value.data()) != objValue.End();
+
+        return presets;
     }
 
-    // ReSharper disable once CppPassValueParameterByConstReference
-    bool JSONParser::IsSubKeyInJsonConfigKey(const char* key, const std::string_view subKey) {
-        const auto obj{presetDistributionConfig.FindMember(key)};
-        return obj != presetDistributionConfig.MemberEnd() && obj->value.HasMember(subKey.data());
+    void CompileNameSet(const rapidjson::Document& a_config, const char* a_key, CompiledRules::NameSet& a_set) {
+        const auto itr{a_config.FindMember(a_key)};
+        if (itr == a_config.MemberEnd() || !itr->value.IsArray()) return;
+
+        a_set.reserve(itr->value.Size());
+        for (const auto& item : itr->value.GetArray()) {
+            if (item.IsString()) a_set.emplace(item.GetString());
+        }
+    }
+
+    void CompileSexSpecificRules(const rapidjson::Document& a_config, const bool female,
+                                 const boost::unordered_flat_map<RE::FormID, categorizedList>& a_characterCategorySet,
+                                 const boost::unordered_flat_map<std::string, RE::FormID>& a_raceByEditorID,
+                                 CompiledRules::SexSpecificRules& a_rules) {
+        const auto& presetContainer{PresetManager::PresetContainer::GetInstance()};
+        const auto end{a_config.MemberEnd()};
+
+        for (const auto& character : a_characterCategorySet | std::views::values) {
+            if (character.bodyslidePresets.empty()) continue;
+
+            CompiledRules::PresetList presets;
+            presets.reserve(character.bodyslidePresets.size());
+            for (const auto& presetName : character.bodyslidePresets) {
+                if (const auto* preset{presetContainer.FindPresetByName(presetName, female)}) {
+                    presets.push_back(preset);
+                }
+            }
+
+            a_rules.presetsByNPCFormID.emplace(character.formID, std::move(presets));
+        }
+
+        if (const auto npc{a_config.FindMember("npc")}; npc != end && npc->value.IsObject()) {
+            for (const auto& [name, presetNames] : npc->value.GetObject()) {
+                a_rules.presetsByNPCName.emplace(name.GetString(), ResolvePresetList(presetNames, female));
+            }
+        }
+
+        if (const auto faction{a_config.FindMember(female ? "factionFemale" : "factionMale")};
+            faction != end && faction->value.IsObject()) {
+            uint32_t rank{};
+            for (const auto& [factionEditorID, presetNames] : faction->value.GetObject()) {
+                if (const auto* form{RE::TESForm::LookupByEditorID(factionEditorID.GetString())}) {
+                    a_rules.presetsByFaction.emplace(form->GetFormID(),
+                                                     CompiledRules::RankedPresetList{
+                                                         rank, ResolvePresetList(presetNames, female)});
+                }
+                ++rank;
+            }
+        }
+
+        if (const auto plugin{a_config.FindMember(female ? "npcPluginFemale" : "npcPluginMale")};
+            plugin != end && plugin->value.IsObject()) {
+            uint32_t rank{};
+            for (const auto& [pluginName, presetNames] : plugin->value.GetObject()) {
+                a_rules.presetsByPlugin.emplace(
+                    pluginName.GetString(),
+                    CompiledRules::RankedPresetList{rank, ResolvePresetList(presetNames, female)});
+                ++rank;
+            }
+        }
+
+        if (const auto race{a_config.FindMember(female ? "raceFemale" : "raceMale")};
+            race != end && race->value.IsObject()) {
+            for (const auto& [raceEditorID, presetNames] : race->value.GetObject()) {
+                if (const auto raceItr{a_raceByEditorID.find(raceEditorID.GetString())};
+                    raceItr != a_raceByEditorID.end()) {
+                    a_rules.presetsByRace.emplace(raceItr->second, ResolvePresetList(presetNames, female));
+                }
+            }
+        }
+
+        CompileNameSet(a_config, female ? "blacklistedNpcsPluginFemale" : "blacklistedNpcsPluginMale",
+                       a_rules.blacklistedPlugins);
+
+        if (const auto blacklistedRaces{
+                a_config.FindMember(female ? "blacklistedRacesFemale" : "blacklistedRacesMale")};
+            blacklistedRaces != end && blacklistedRaces->value.IsArray()) {
+            for (const auto& raceEditorID : blacklistedRaces->value.GetArray()) {
+                if (!raceEditorID.IsString()) continue;
+                if (const auto raceItr{a_raceByEditorID.find(raceEditorID.GetString())};
+                    raceItr != a_raceByEditorID.end()) {
+                    a_rules.blacklistedRaces.emplace(raceItr->second);
+                }
+            }
+        }
+
+        logger::info(
+            "Compiled {} rules: {} npcFormID, {} npc, {} faction, {} plugin, {} race, {} blacklisted plugins, {} "
+            "blacklisted races",
+            female ? "female" : "male", a_rules.presetsByNPCFormID.size(), a_rules.presetsByNPCName.size(),
+            a_rules.presetsByFaction.size(), a_rules.presetsByPlugin.size(), a_rules.presetsByRace.size(),
+            a_rules.blacklistedPlugins.size(), a_rules.blacklistedRaces.size());
+    }
+
+    void JSONParser::CompileRules() {
+        [[maybe_unused]] stl::timeit const t;
+        logger::info(TitleFormatSpecifier, "Compiling distribution rules");
+
+        compiledRules = {};
+        // The decisions and classifications were made according to the rules that we're about to replace.
+        distributionDecisionForNPC.clear();
+        outfitClassificationForArmor.clear();
+
+        // The config refers to races by their editor-ID, but there's no need to build
+        // editor-ID strings for every actor we process when we can match races by form-ID instead.
+        boost::unordered_flat_map<std::string, RE::FormID> raceByEditorID;
+        for (const auto* race : RE::TESDataHandler::GetSingleton()->GetFormArray<RE::TESRace>()) {
+            if (race) raceByEditorID.emplace(stl::get_editorID(race->As<RE::TESForm>()), race->GetFormID());
+        }
+
+        CompileNameSet(presetDistributionConfig, "blacklistedNpcs", compiledRules.blacklistedNPCNames);
+        CompileNameSet(presetDistributionConfig, "blacklistedOutfitsFromORefit", compiledRules.blacklistedOutfitNames);
+        CompileNameSet(presetDistributionConfig, "blacklistedOutfitsFromORefitPlugin",
+                       compiledRules.blacklistedOutfitPlugins);
+        CompileNameSet(presetDistributionConfig, "outfitsForceRefit", compiledRules.forceRefitOutfitNames);
+
+        CompileSexSpecificRules(presetDistributionConfig, true, characterCategorySet, raceByEditorID,
+                                compiledRules.female);
+        CompileSexSpecificRules(presetDistributionConfig, false, characterCategorySet, raceByEditorID,
+                                compiledRules.male);
+
+        logger::info("Compiled rules: {} blacklisted npcs, {} blacklisted outfits, {} blacklisted outfit plugins, {} "
+                     "force-refit outfits",
+                     compiledRules.blacklistedNPCNames.size(), compiledRules.blacklistedOutfitNames.size(),
+                     compiledRules.blacklistedOutfitPlugins.size(), compiledRules.forceRefitOutfitNames.size());
+    }
+
+    const PresetManager::Preset* GetRandomPresetFromList(const CompiledRules::PresetList& a_presets) {
+        if (a_presets.empty()) {
+            logger::info("Preset names size is empty, returning none");
+            return nullptr;
+        }
+
+        static_assert(std::is_same_v<decltype(0llu), decltype(a_presets.size())>,
+                      "Ensure that below literal is of type std::size_t");
+        return a_presets[stl::random(0llu, a_presets.size())];
+    }
+
+    OutfitClassification JSONParser::ClassifyOutfit(const RE::TESObjectARMO& a_outfit) {
+        const auto formID{a_outfit.GetFormID()};
+
+        if (OutfitClassification classification;
+            outfitClassificationForArmor.visit(formID, [&](const auto& entry) { classification = entry.second; })) {
+            return classification;
+        }
+
+        const std::string_view name{a_outfit.GetName()};
+
+        OutfitClassification classification;
+        classification.blacklisted =
+            compiledRules.blacklistedOutfitNames.contains(name) || IsOutfitInBlacklistedOutfitCategorySet(formID) ||
+            compiledRules.blacklistedOutfitPlugins.contains(GetNthFormLocationName(a_outfit.As<RE::TESForm>(), 0));
+        classification.forcesRefit =
+            compiledRules.forceRefitOutfitNames.contains(name) || IsOutfitInForceRefitCategorySet(formID);
+
+        // Dynamic forms have their form-IDs recycled once they're no longer in use,
+        // so we can't be sure that the next armor we see with the same form-ID is the same armor.
+        if (!a_outfit.IsDynamicForm()) outfitClassificationForArmor.emplace(formID, classification);
+
+        return classification;
     }
 
     bool JSONParser::IsOutfitBlacklisted(const RE::TESObjectARMO& a_outfit) {
-        return IsStringInJsonConfigKey(a_outfit.GetName(), "blacklistedOutfitsFromORefit") ||
-               IsOutfitInBlacklistedOutfitCategorySet(a_outfit.GetFormID()) ||
-               IsStringInJsonConfigKey(GetNthFormLocationName(a_outfit.As<RE::TESForm>(), 0),
-                                       "blacklistedOutfitsFromORefitPlugin");
+        return ClassifyOutfit(a_outfit).blacklisted;
     }
 
     bool JSONParser::IsAnyForceRefitItemEquipped(RE::Actor* a_actor, const bool a_removingArmor,
                                                  const RE::TESForm* a_equippedArmor) {
-        auto inventory = a_actor->GetInventory() | std::views::transform([](const auto& pair) {
-                             return std::pair<RE::TESBoundObject*, const std::unique_ptr<RE::InventoryEntryData>&>(
-                                 pair.first, pair.second.second);  // Return the unique_ptr directly
-                         });
-
-        // std::vector<std::string> wornItems;
+        // Most configs don't force ORefit for any outfits at all.
+        if (compiledRules.forceRefitOutfitNames.empty() && forceRefitOutfitCategorySet.empty()) {
+            return false;
+        }
 
-        for (const auto& [bound_obj, inventory_entry_data] : inventory) {
-            if (inventory_entry_data->IsWorn()) {
-                // Check if the item is being unequipped or not first
-                if (a_removingArmor && bound_obj->GetFormID() == a_equippedArmor->GetFormID()) {
-                    continue;
-                }
+        auto forcesRefit = [&](const RE::TESObjectARMO* a_armor) {
+            // Check if the item is being unequipped or not first
+            if (a_removingArmor && a_armor == a_equippedArmor) return false;
 
-                if (const RE::FormType itemFormType = bound_obj->GetFormType();
-                    (itemFormType == RE::FormType::Armor || itemFormType == RE::FormType::Armature) &&
-                        IsStringInJsonConfigKey(inventory_entry_data->GetDisplayName(), "outfitsForceRefit") ||
-                    IsOutfitInForceRefitCategorySet(bound_obj->GetFormID())) {
-                    logger::info("Outfit {} is in force refit list", inventory_entry_data->GetDisplayName());
+            if (!ClassifyOutfit(*a_armor).forcesRefit) return false;
 
-                    return true;
-                }
+            OBODY_ACTOR_LOG("Outfit {} is in force refit list", a_armor->GetName());
+            return true;
+        };
+
+        // The biped has an object per slot, holding the item worn in it, so looking at it costs the same
+        // however large the actor's inventory is.
+        if (const auto& biped{a_actor->GetCurrentBiped()}) {
+            const RE::TESObjectARMO* previousArmor{nullptr};
+            for (const auto& object : biped->objects) {
+                const auto* const armor{object.item ? object.item->As<RE::TESObjectARMO>() : nullptr};
+                // An armor covering several slots is in each of their objects, which are only one after another
+                // when nothing else is worn in the slots between them, so this only skips the consecutive repeats.
+                // Classifying an armor twice merely costs us the lookup, as it's the same answer either way.
+                if (!armor || armor == previousArmor) continue;
+
+                previousArmor = armor;
+                if (forcesRefit(armor)) return true;
             }
+
+            return false;
+        }
+
+        // Actors without their 3D have no biped, so we're left with the worn entries of their inventory changes,
+        // as being worn is recorded in the entries' extra data.
+        auto* const inventoryChanges{a_actor->GetInventoryChanges()};
+        if (!inventoryChanges || !inventoryChanges->entryList) {
+            return false;
+        }
+
+        for (const auto* entry : *inventoryChanges->entryList) {
+            if (!entry || !entry->object || !entry->IsWorn()) continue;
+
+            const auto* const armor{entry->object->As<RE::TESObjectARMO>()};
+            if (armor && forcesRefit(armor)) return true;
         }
 
         return false;
     }
 
     // ReSharper disable once CppPassValueParameterByConstReference
-    bool JSONParser::IsNPCBlacklisted(const std::string_view actorName, const uint32_t actorID) {
-        if (IsStringInJsonConfigKey(actorName.data(), "blacklistedNpcs")) {
-            logger::info("{} is Blacklisted by blacklistedNpcs", actorName);
+    bool JSONParser::IsNPCBlacklisted(const std::string_view actorName, const uint32_t actorID) const {
+        if (compiledRules.blacklistedNPCNames.contains(actorName)) {
+            OBODY_ACTOR_LOG("{} is Blacklisted by blacklistedNpcs", actorName);
             return true;
         }
 
         if (IsActorInBlacklistedCharacterCategorySet(actorID)) {
-            logger::info("{} is Blacklisted by character category set", actorName);
+            OBODY_ACTOR_LOG("{} is Blacklisted by character category set", actorName);
             return true;
         }
 
         return false;
     }
 
-    bool JSONParser::IsNPCBlacklistedGlobally(const RE::Actor* a_actor, const char* actorRace, const bool female) {
-        const auto actorOwningMod{GetNthFormLocationName(a_actor, 0)};
+    bool JSONParser::IsNPCPluginBlacklisted(const RE::Actor* a_actor, const bool female) const {
+        return (female ? compiledRules.female : compiledRules.male)
+            .blacklistedPlugins.contains(GetNthFormLocationName(a_actor, 0));
+    }
 
-        if (female) {
-            return IsStringInJsonConfigKey(actorOwningMod, "blacklistedNpcsPluginFemale") ||
-                   IsStringInJsonConfigKey(actorRace, "blacklistedRacesFemale");
-        }
-        return IsStringInJsonConfigKey(actorOwningMod, "blacklistedNpcsPluginMale") ||
-               IsStringInJsonConfigKey(actorRace, "blacklistedRacesMale");
+    bool JSONParser::IsNPCRaceBlacklisted(const RE::TESRace* actorRace, const bool female) const {
+        return actorRace &&
+               (female ? compiledRules.female : compiledRules.male).blacklistedRaces.contains(actorRace->GetFormID());
     }
 
-    std::optional<PresetManager::Preset> JSONParser::GetNPCFactionPreset(const RE::TESNPC* a_actor, const bool female) {
-        auto actorRanks{a_actor->factions | std::views::transform(&RE::FACTION_RANK::faction)};
+    // A list that's been matched but is empty, because none of its presets are installed,
+    // is treated as though it was never matched, so that the next key in line gets a say.
+    const CompiledRules::PresetList* NonEmptyOrNull(const CompiledRules::PresetList& a_presets) {
+        return a_presets.empty() ? nullptr : &a_presets;
+    }
 
-        const std::vector<RE::TESFaction*> actorFactions{actorRanks.begin(), actorRanks.end()};
+    const CompiledRules::PresetList* JSONParser::GetNPCFactionPresets(const RE::TESNPC* a_actor,
+                                                                      const bool female) const {
+        const auto& presetsByFaction{(female ? compiledRules.female : compiledRules.male).presetsByFaction};
 
-        if (actorFactions.empty()) {
-            return std::nullopt;
+        if (presetsByFaction.empty()) {
+            return nullptr;
         }
 
-        const auto& presetContainer{PresetManager::PresetContainer::GetInstance()};
-        const PresetManager::PresetSet presetSet{female ? presetContainer.allFemalePresets
-                                                        : presetContainer.allMalePresets};
-
-        auto& a_faction{presetDistributionConfig[female ? "factionFemale" : "factionMale"]};
-
-        for (auto itr = a_faction.MemberBegin(); itr != a_faction.MemberEnd(); ++itr) {
-            auto& [key, value]{*itr};
-            if (std::ranges::find(actorFactions, RE::TESFaction::LookupByEditorID(key.GetString())) !=
-                actorFactions.end()) {
-                std::vector<std::string_view> copy_of_value{value.Size()};
-                for (const auto& item : value.GetArray()) {
-                    copy_of_value.emplace_back(item.GetString());
-                }
+        const CompiledRules::RankedPresetList* match{};
 
-                return PresetManager::GetRandomPresetByName(presetSet, copy_of_value, female);
+        for (const auto& factionRank : a_actor->factions) {
+            if (!factionRank.faction) continue;
+
+            if (const auto itr{presetsByFaction.find(factionRank.faction->GetFormID())};
+                itr != presetsByFaction.end() && (!match || itr->second.rank < match->rank)) {
+                match = &itr->second;
             }
         }
 
-        return std::nullopt;
+        return match ? NonEmptyOrNull(match->presets) : nullptr;
     }
 
-    std::optional<PresetManager::Preset> JSONParser::GetNPCPreset(const char* actorName, const uint32_t formID,
-                                                                  const bool female) {
-        const auto& presetContainer{PresetManager::PresetContainer::GetInstance()};
+    const CompiledRules::PresetList* JSONParser::GetNPCPresets(const char* actorName, const uint32_t formID,
+                                                               const bool female) const {
+        const auto& rules{female ? compiledRules.female : compiledRules.male};
 
-        const PresetManager::PresetSet presetSet{female ? presetContainer.allFemalePresets
-                                                        : presetContainer.allMalePresets};
+        if (const auto itr{rules.presetsByNPCFormID.find(formID)}; itr != rules.presetsByNPCFormID.end()) {
+            return NonEmptyOrNull(itr->second);
+        }
 
-        const auto character{GetNPCFromCategorySet(formID)};
+        if (actorName) {
+            if (const auto itr{rules.presetsByNPCName.find(std::string_view{actorName})};
+                itr != rules.presetsByNPCName.end()) {
+                return NonEmptyOrNull(itr->second);
+            }
+        }
 
-        std::vector<std::string_view> characterBodyslidePresets;
+        return nullptr;
+    }
 
-        if (character.has_value()) {
-            if (!character->bodyslidePresets.empty()) {
-                characterBodyslidePresets.insert_range(characterBodyslidePresets.end(), character->bodyslidePresets);
-                return PresetManager::GetRandomPresetByName(presetSet, characterBodyslidePresets, female);
-            }
+    const CompiledRules::PresetList* JSONParser::GetNPCPluginPresets(const RE::TESNPC* a_actor,
+                                                                     const char* actorName,
+                                                                     const bool female) const {
+        const auto& presetsByPlugin{(female ? compiledRules.female : compiledRules.male).presetsByPlugin};
+
+        if (presetsByPlugin.empty() || !GetHasSourceFileArray(a_actor)) {
+            return nullptr;
         }
-        if (const auto npcItr{presetDistributionConfig.FindMember("npc")};
-            npcItr != presetDistributionConfig.MemberEnd()) {
-            const auto npcActorItr{npcItr->value.FindMember(actorName)};
 
-            if (npcActorItr == npcItr->value.MemberEnd()) return {};
+        const CompiledRules::RankedPresetList* match{};
 
-            characterBodyslidePresets.reserve(npcActorItr->value.Size());
-            for (const auto& item : npcActorItr->value.GetArray()) {
-                characterBodyslidePresets.emplace_back(item.GetString());
+        RE::TESFile** sourceFiles{a_actor->sourceFiles.array->data()};
+        for (std::uint32_t i{}; i < a_actor->sourceFiles.array->size(); i++) {
+            if (const auto itr{presetsByPlugin.find(std::string_view{sourceFiles[i]->fileName})};
+                itr != presetsByPlugin.end() && (!match || itr->second.rank < match->rank)) {
+                match = &itr->second;
             }
-            return PresetManager::GetRandomPresetByName(presetSet, characterBodyslidePresets, female);
         }
-        return std::nullopt;
-    }
 
-    std::optional<PresetManager::Preset> JSONParser::GetNPCPluginPreset(const RE::TESNPC* a_actor,
-                                                                        const char* actorName, const bool female) {
-        const char* keyForPreset{female ? "npcPluginFemale" : "npcPluginMale"};
+        if (!match) {
+            return nullptr;
+        }
 
-        if (presetDistributionConfig.HasMember(keyForPreset)) {
-            auto& presets = presetDistributionConfig[keyForPreset];
-            for (auto itr = presets.MemberBegin(); itr != presets.MemberEnd(); ++itr) {
-                auto& [mod, presetList] = *itr;
-                logger::info("Checking if actor {} is in mod {}", actorName, mod.GetString());
+        OBODY_ACTOR_LOG("Actor {} is in a plugin with presets defined for it", actorName);
 
-                if (IsActorInForm(a_actor, mod.GetString())) {
-                    const auto& presetContainer{PresetManager::PresetContainer::GetInstance()};
+        return NonEmptyOrNull(match->presets);
+    }
 
-                    const PresetManager::PresetSet presetSet{female ? presetContainer.allFemalePresets
-                                                                    : presetContainer.allMalePresets};
+    const CompiledRules::PresetList* JSONParser::GetNPCRacePresets(const RE::TESRace* actorRace,
+                                                                   const bool female) const {
+        if (!actorRace) {
+            return nullptr;
+        }
 
-                    std::vector<std::string_view> presets_copy{presets[mod].Size()};
-                    for (const auto& item : presets[mod].GetArray()) {
-                        presets_copy.emplace_back(item.GetString());
-                    }
+        const auto& presetsByRace{(female ? compiledRules.female : compiledRules.male).presetsByRace};
 
-                    return GetRandomPresetByName(presetSet, presets_copy, female);
-                }
-            }
+        if (const auto itr{presetsByRace.find(actorRace->GetFormID())}; itr != presetsByRace.end()) {
+            return NonEmptyOrNull(itr->second);
         }
 
-        return std::nullopt;
+        return nullptr;
     }
 
-    std::optional<PresetManager::Preset> JSONParser::GetNPCRacePreset(const char* actorRace, const bool female) {
-        const char* key{female ? "raceFemale" : "raceMale"};
+    DistributionDecision JSONParser::GetDistributionDecision(const RE::TESNPC* a_actorBase, const bool female) {
+        Instrumentation::ScopedTimer const timer{Instrumentation::Stage::DistributionDecision};
 
-        if (IsSubKeyInJsonConfigKey(key, actorRace)) {
-            const auto& presetContainer{PresetManager::PresetContainer::GetInstance()};
+        using Outcome = DistributionDecision::Outcome;
 
-            const PresetManager::PresetSet presetSet{female ? presetContainer.allFemalePresets
-                                                            : presetContainer.allMalePresets};
-            std::vector<std::string_view> presets_copy{presetDistributionConfig[key][actorRace].Size()};
-            for (const auto& item : presetDistributionConfig[key][actorRace].GetArray()) {
-                presets_copy.emplace_back(item.GetString());
-            }
-            return PresetManager::GetRandomPresetByName(presetSet, presets_copy, female);
+        // Dynamic bases, such as those the game makes for leveled actors, have their form-IDs recycled
+        // once they're no longer in use, so any decision we kept for one could end up applied to a stranger.
+        const bool memoizable{!a_actorBase->IsDynamicForm()};
+        const uint64_t key{(uint64_t{a_actorBase->GetFormID()} << 1) | uint64_t{female}};
+
+        if (DistributionDecision decision;
+            memoizable && distributionDecisionForNPC.visit(key, [&](const auto& entry) { decision = entry.second; })) {
+            return decision;
         }
 
-        return std::nullopt;
+        const auto* actorName{a_actorBase->GetName()};
+        const auto actorID{a_actorBase->GetFormID()};
+
+        auto decide = [&]() -> DistributionDecision {
+            if (IsNPCBlacklisted(actorName, actorID)) {
+                return {Outcome::Blacklisted};
+            }
+
+            // First, we attempt to get the NPC's presets from the keys npcFormID and npc from the JSON
+            if (const auto* presets{GetNPCPresets(actorName, actorID, female)}) {
+                return {Outcome::NPCPresets, presets};
+            }
+
+            const auto* actorRace{a_actorBase->GetRace()};
+
+            // If we can't find them, we check if the NPC is blacklisted by race
+            if (IsNPCRaceBlacklisted(actorRace, female)) {
+                return {Outcome::Blacklisted};
+            }
+
+            // Next up, we check if we have presets defined in one of the NPC's factions
+            const auto* presets{GetNPCFactionPresets(a_actorBase, female)};
+
+            // If that also fails, we check if we have presets in the NPC's plugin
+            if (presets == nullptr) {
+                presets = GetNPCPluginPresets(a_actorBase, actorName, female);
+            }
+
+            // And if that also fails, we check if we have presets in the NPC's race
+            if (presets == nullptr) {
+                presets = GetNPCRacePresets(actorRace, female);
+            }
+
+            return {Outcome::DistributedPresets, presets};
+        };
+
+        const auto decision{decide()};
+
+        if (memoizable) distributionDecisionForNPC.emplace(key, decision);
+
+        return decision;
     }
-}  // namespace Parser
\ No newline at end of file
+}  // namespace Parser
@@ -2,10 +2,14 @@
 // Created by judah on 05-02-2025.
 //
 
+#include "Benchmark/Benchmark.h"
 #include "Body/Body.h"
+#include "Body/GenerationQueue.h"
+#include "Body/MorphScheduler.h"
 #include "PresetManager/PresetManager.h"
 #include "JSONParser/JSONParser.h"
 #include "Papyrus/PapyrusBody.h"
+#include "Reload/Reload.h"
 
 namespace PapyrusBody {
     void GenActor(RE::StaticFunctionTag*, RE::Actor* a_actor) {
@@ -31,6 +35,35 @@ namespace PapyrusBody {
         Body::OBody::GetInstance().setPerformanceMode = a_enabled;
     }
 
+    void SetMorphUpdatesPerFrame(RE::StaticFunctionTag*, const int a_count) {
+        Body::MorphScheduler::GetInstance().morphUpdatesPerFrame = static_cast<uint32_t>(std::max(a_count, 1));
+    }
+
+    void SetDeferredGeneration(RE::StaticFunctionTag*, const bool a_enabled) {
+        Body::GenerationQueue::GetInstance().enabled = a_enabled;
+    }
+
+    void SetDeferredGenerationBudget(RE::StaticFunctionTag*, const int a_microseconds) {
+        Body::GenerationQueue::GetInstance().budgetPerFrameInMicroseconds =
+            static_cast<uint32_t>(std::max(a_microseconds, 0));
+    }
+
+    void SetRandomSeed(RE::StaticFunctionTag*, const int a_seed) {
+        stl::seed_random(static_cast<uint32_t>(a_seed));
+    }
+
+    void SetActorLogging(RE::StaticFunctionTag*, const bool a_enabled) {
+        Instrumentation::actorLogging.store(a_enabled, std::memory_order_relaxed);
+    }
+
+    void DumpStageTimings(RE::StaticFunctionTag*) { Instrumentation::Dump(); }
+
+    void ResetStageTimings(RE::StaticFunctionTag*) { Instrumentation::Reset(); }
+
+    void RunBenchmarks(RE::StaticFunctionTag*, const int a_iterations) {
+        Benchmark::Run(static_cast<uint32_t>(std::max(a_iterations, 1)));
+    }
+
     void SetRespectfulMorphApplication(RE::StaticFunctionTag*, const bool a_enabled) {
         Body::OBody::GetInstance().setRespectfulMorphApplication = a_enabled;
     }
@@ -42,7 +75,12 @@ namespace PapyrusBody {
     // ReSharper disable once CppPassValueParameterByConstReference
     void SetDistributionKey(RE::StaticFunctionTag*,
                             const std::string a_distributionKey) {  // NOLINT(*-unnecessary-value-param)
-        Body::OBody::GetInstance().distributionKey = a_distributionKey;
+        auto& obody{Body::OBody::GetInstance()};
+        if (obody.distributionKey == a_distributionKey) return;
+
+        obody.distributionKey = a_distributionKey;
+        // Whether actors are processed is mirrored from the morph named after the key.
+        obody.ForgetMorphFlags();
     }
 
     int GetFemaleDatabaseSize(RE::StaticFunctionTag*) {
@@ -95,8 +133,13 @@ namespace PapyrusBody {
         obody.ReapplyActorMorphs(a_actor, &obody.specialPapyrusPluginInterface);
     }
 
-    bool presetNameComparison(const std::string_view a, const std::string_view b) {
-        return boost::algorithm::ilexicographical_compare(a, b);
+    void RegenerateLoadedActors(RE::StaticFunctionTag*, const bool a_keepAssignedPresets) {
+        const auto& obody{Body::OBody::GetInstance()};
+        obody.RegenerateLoadedActors(a_keepAssignedPresets, &obody.specialPapyrusPluginInterface);
+    }
+
+    bool ReloadConfig(RE::StaticFunctionTag*) {
+        return Reload::Request(&Body::OBody::GetInstance().specialPapyrusPluginInterface);
     }
 
     std::vector<std::string> GetAllPossiblePresets(RE::StaticFunctionTag*, RE::Actor* a_actor) {
@@ -117,16 +160,15 @@ namespace PapyrusBody {
                 "in OBody menu.");
         }
 
-        auto presets_to_show =
-            (Body::OBody::IsFemale(a_actor)
-                 ? (showBlacklistedPresets ? presetContainer.allFemalePresets : presetContainer.femalePresets)
-                 : (showBlacklistedPresets ? presetContainer.allMalePresets : presetContainer.malePresets)) |
-            std::views::transform(&PresetManager::Preset::name);
-
-        std::vector ret(presets_to_show.begin(), presets_to_show.end());
-        std::ranges::sort(ret, presetNameComparison);
+        // The names were sorted when the presets were loaded.
+        const auto& presetNames{
+            Body::OBody::IsFemale(a_actor)
+                ? (showBlacklistedPresets ? presetContainer.sortedAllFemalePresetNames
+                                          : presetContainer.sortedFemalePresetNames)
+                : (showBlacklistedPresets ? presetContainer.sortedAllMalePresetNames
+                                          : presetContainer.sortedMalePresetNames)};
 
-        return ret;
+        return std::vector<std::string>(presetNames.begin(), presetNames.end());
     }
 
     std::string GetPresetAssignedToActor(RE::StaticFunctionTag*, RE::Actor* a_actor) {
@@ -169,18 +211,20 @@ namespace PapyrusBody {
             }
 
             if (previousPresetIndex != 0) {
-                obody.SendActorChangeEvent(
+                obody.SendActorChangeEvent<::OBody::API::ActorChangeEventActorPresetChangedWithoutGeneration>(
                     a_actor,
                     [&] {
                         using Event = ::OBody::API::IActorChangeEventListener;
 
+                        // Minus one because an index of zero assigned to the actor signifies the absence of a preset.
+                        const PresetManager::AssignedPresetIndex presetIndex{previousPresetIndex - 1};
+                        // Note that the plugin-API mandates that this be a null-terminated string.
+                        const auto presetName{presetIndex.GetPresetNameView(obody.IsFemale(a_actor))};
+
+                        // The preset may have gone since, such as to a reload, leaving no index to speak of.
                         Event::OnActorPresetChangedWithoutGeneration::Payload payload{
-                            &obody.specialPapyrusPluginInterface,
-                            // Note that the plugin-API mandates that this be a null-terminated string.
-                            // Minus one because an index of zero assigned to the actor signifies the absence of a
-                            // preset.
-                            PresetManager::AssignedPresetIndex{previousPresetIndex - 1}.GetPresetNameView(
-                                obody.IsFemale(a_actor))};
+                            &obody.specialPapyrusPluginInterface, presetName,
+                            presetName.empty() ? ::OBody::API::IPluginInterfaceV2::NoPresetIndex : presetIndex.value};
 
                         auto flags = Event::OnActorPresetChangedWithoutGeneration::Flags::PresetWasUnassigned;
 
@@ -196,9 +240,7 @@ namespace PapyrusBody {
 
         bool isFemale = Body::OBody::IsFemale(a_actor);
 
-        const auto& presetContainer{PresetManager::PresetContainer::GetInstance()};
-        auto preset = GetPresetByNameForRandom(
-            isFemale ? presetContainer.allFemalePresets : presetContainer.allMalePresets, a_presetName);
+        auto preset = PresetManager::GetPresetByNameForRandom(a_presetName, isFemale);
 
         if (!preset) {
             return false;
@@ -223,7 +265,7 @@ namespace PapyrusBody {
             registry.stateForActor.emplace_or_visit(formID, fallbackActorState,
                                                     [&](auto& entry) { entry.second.presetIndex = actorPresetIndex; });
 
-            obody.SendActorChangeEvent(
+            obody.SendActorChangeEvent<::OBody::API::ActorChangeEventActorPresetChangedWithoutGeneration>(
                 a_actor,
                 [&] {
                     using Event = ::OBody::API::IActorChangeEventListener;
@@ -231,7 +273,7 @@ namespace PapyrusBody {
                     Event::OnActorPresetChangedWithoutGeneration::Payload payload{
                         &obody.specialPapyrusPluginInterface,
                         // Note that the plugin-API mandates that this be a null-terminated string.
-                        assignedPresetIndex.GetPresetNameView(isFemale)};
+                        assignedPresetIndex.GetPresetNameView(isFemale), assignedPresetIndex.value};
 
                     Event::OnActorPresetChangedWithoutGeneration::Flags flags{};
 
@@ -262,6 +304,8 @@ namespace PapyrusBody {
         OBODY_PAPYRUS_BIND(GetMaleDatabaseSize);
         OBODY_PAPYRUS_BIND(ResetActorOBodyMorphs);
         OBODY_PAPYRUS_BIND(ReapplyActorOBodyMorphs);
+        OBODY_PAPYRUS_BIND(RegenerateLoadedActors);
+        OBODY_PAPYRUS_BIND(ReloadConfig);
         OBODY_PAPYRUS_BIND(GetPresetAssignedToActor);
         OBODY_PAPYRUS_BIND(AssignPresetToActor);
 
@@ -270,6 +314,14 @@ namespace PapyrusBody {
         OBODY_PAPYRUS_BIND(SetNippleRand);
         OBODY_PAPYRUS_BIND(SetGenitalRand);
         OBODY_PAPYRUS_BIND(SetPerformanceMode);
+        OBODY_PAPYRUS_BIND(SetMorphUpdatesPerFrame);
+        OBODY_PAPYRUS_BIND(SetDeferredGeneration);
+        OBODY_PAPYRUS_BIND(SetDeferredGenerationBudget);
+        OBODY_PAPYRUS_BIND(SetRandomSeed);
+        OBODY_PAPYRUS_BIND(SetActorLogging);
+        OBODY_PAPYRUS_BIND(DumpStageTimings);
+        OBODY_PAPYRUS_BIND(ResetStageTimings);
+        OBODY_PAPYRUS_BIND(RunBenchmarks);
         OBODY_PAPYRUS_BIND(SetRespectfulMorphApplication);
         OBODY_PAPYRUS_BIND(SetLegacyStorageUtilUsageEnabled);
         OBODY_PAPYRUS_BIND(SetDistributionKey);
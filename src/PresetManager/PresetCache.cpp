@@ -0,0 +1,221 @@
+#include "PresetManager/PresetCache.h"
+
+namespace PresetCache {
+    namespace {
+        // The preset sets that we cache, in the order in which the cache stores them.
+        constexpr std::array<PresetManager::PresetSet PresetManager::PresetSets::*, 4> CachedPresetSets{
+            &PresetManager::PresetSets::femalePresets, &PresetManager::PresetSets::malePresets,
+            &PresetManager::PresetSets::blacklistedFemalePresets, &PresetManager::PresetSets::blacklistedMalePresets};
+    }  // namespace
+
+    uint64_t ComputeFingerprint(const std::vector<fs::path>& a_presetFiles,
+                                const rapidjson::Value& a_blacklistedPresets) {
+        stl::Fingerprinter fingerprint;
+        fingerprint.Add(FormatVersion);
+
+        fingerprint.Add(a_presetFiles.size());
+        for (const auto& path : a_presetFiles) {
+            const auto fileName{path.filename().wstring()};
+            fingerprint.Add(fileName.size());
+            fingerprint.Add(fileName.data(), fileName.size() * sizeof(wchar_t));
+
+            // Should we fail to stat a file, we fingerprint it such that it never matches,
+            // as we'd rather re-parse the presets than risk using stale ones.
+            std::error_code ec;
+            const auto fileSize{fs::file_size(path, ec)};
+            fingerprint.Add(ec ? static_cast<uint64_t>(-1) : static_cast<uint64_t>(fileSize));
+
+            const auto lastWriteTime{fs::last_write_time(path, ec)};
+            fingerprint.Add(ec ? std::chrono::steady_clock::now().time_since_epoch().count()
+                               : static_cast<int64_t>(lastWriteTime.time_since_epoch().count()));
+        }
+
+        fingerprint.Add(a_blacklistedPresets.Size());
+        for (const auto& presetName : a_blacklistedPresets.GetArray()) {
+            fingerprint.Add(presetName.GetStringLength());
+            fingerprint.Add(presetName.GetString(), presetName.GetStringLength());
+        }
+
+        return fingerprint.hash;
+    }
+
+    bool Load(const uint64_t a_fingerprint, PresetManager::PresetSets& a_presets, std::size_t& a_invalidPresetFiles) {
+        [[maybe_unused]] stl::timeit const t;
+
+        std::error_code ec;
+        const auto fileSize{fs::file_size(CachePath, ec)};
+        if (ec || fileSize < sizeof(HeaderV1)) {
+            logger::info("No preset cache found, parsing the presets.");
+            return false;
+        }
+
+        std::vector<uint8_t> data(fileSize);
+        {
+            const stl::FilePtrManager file{CachePath, "rb"};
+            if (!file.get() || fread(data.data(), 1, data.size(), file.get()) != data.size()) {
+                logger::warn("Failed to read the preset cache, parsing the presets.");
+                return false;
+            }
+        }
+
+        HeaderV1 header;
+        std::memcpy(&header, data.data(), sizeof(header));
+
+        if (header.magic != Magic || header.version != FormatVersion) {
+            logger::info("The preset cache was written by another version of OBody, parsing the presets.");
+            return false;
+        }
+
+        if (header.fingerprint != a_fingerprint) {
+            logger::info("The presets have changed since the preset cache was written, parsing the presets.");
+            return false;
+        }
+
+        uint64_t presetCount{0};
+        for (const auto count : header.presetCounts) presetCount += count;
+
+        if (sizeof(HeaderV1) + presetCount * sizeof(PresetRecordV1) + header.sliderCount * sizeof(SliderRecordV1) +
+                header.stringTableSize !=
+            data.size()) {
+            logger::warn("The preset cache is corrupt, parsing the presets.");
+            return false;
+        }
+
+        // The vector's storage is suitably aligned for the records, and the header keeps them aligned.
+        const auto* presetRecord{reinterpret_cast<const PresetRecordV1*>(data.data() + sizeof(HeaderV1))};
+        const auto* sliderRecords{reinterpret_cast<const SliderRecordV1*>(presetRecord + presetCount)};
+        const auto* strings{reinterpret_cast<const char*>(sliderRecords + header.sliderCount)};
+
+        auto stringAt = [&](const uint32_t offset, const uint32_t length, std::string_view& a_string) {
+            if (uint64_t{offset} + length > header.stringTableSize) return false;
+
+            a_string = {strings + offset, length};
+            return true;
+        };
+
+        auto& sliderNames{PresetManager::SliderNameTable::GetInstance()};
+
+        // We only touch the container once the whole cache has been read back successfully.
+        std::array<PresetManager::PresetSet, CachedPresetSets.size()> presetSets;
+
+        for (std::size_t set = 0; set < presetSets.size(); ++set) {
+            presetSets[set].reserve(header.presetCounts[set]);
+
+            for (uint32_t i = 0; i < header.presetCounts[set]; ++i, ++presetRecord) {
+                std::string_view name, body;
+                if (!stringAt(presetRecord->nameOffset, presetRecord->nameLength, name) ||
+                    !stringAt(presetRecord->bodyOffset, presetRecord->bodyLength, body) ||
+                    uint64_t{presetRecord->firstSlider} + presetRecord->sliderCount > header.sliderCount) {
+                    logger::warn("The preset cache is corrupt, parsing the presets.");
+                    return false;
+                }
+
+                auto& preset{presetSets[set].emplace_back()};
+                preset.name = name;
+                preset.body = body;
+                preset.sliders.reserve(presetRecord->sliderCount);
+
+                for (const auto& sliderRecord :
+                     std::span{sliderRecords + presetRecord->firstSlider, presetRecord->sliderCount}) {
+                    std::string_view sliderName;
+                    if (!stringAt(sliderRecord.nameOffset, sliderRecord.nameLength, sliderName)) {
+                        logger::warn("The preset cache is corrupt, parsing the presets.");
+                        return false;
+                    }
+
+                    preset.sliders.push_back(sliderNames.Intern(sliderName), sliderRecord.min, sliderRecord.max);
+                }
+            }
+        }
+
+        for (std::size_t set = 0; set < presetSets.size(); ++set) {
+            std::ranges::move(presetSets[set], std::back_inserter(a_presets.*CachedPresetSets[set]));
+        }
+
+        a_invalidPresetFiles += header.invalidPresetFiles;
+
+        logger::info("Loaded {} presets from the preset cache.", presetCount);
+
+        return true;
+    }
+
+    void Save(const uint64_t a_fingerprint, const PresetManager::PresetSets& a_presets,
+              const std::size_t a_invalidPresetFiles) {
+        [[maybe_unused]] stl::timeit const t;
+
+        HeaderV1 header{};
+        header.magic = Magic;
+        header.version = FormatVersion;
+        header.fingerprint = a_fingerprint;
+        header.invalidPresetFiles = static_cast<uint32_t>(a_invalidPresetFiles);
+
+        const auto& sliderNames{PresetManager::SliderNameTable::GetInstance()};
+
+        std::vector<PresetRecordV1> presetRecords;
+        std::vector<SliderRecordV1> sliderRecords;
+        std::string strings;
+
+        // Most presets share the same few hundred slider names, so we store each distinct string only once.
+        // The keys view the container's and the slider-name table's strings, which outlive this function.
+        boost::unordered_flat_map<std::string_view, uint32_t> stringOffsets;
+        auto addString = [&](const std::string_view a_string) {
+            const auto [itr, inserted]{stringOffsets.try_emplace(a_string, static_cast<uint32_t>(strings.size()))};
+            if (inserted) strings.append(a_string);
+            return itr->second;
+        };
+
+        for (std::size_t set = 0; set < CachedPresetSets.size(); ++set) {
+            const auto& presets{a_presets.*CachedPresetSets[set]};
+            header.presetCounts[set] = static_cast<uint32_t>(presets.size());
+
+            for (const auto& preset : presets) {
+                presetRecords.push_back({addString(preset.name), static_cast<uint32_t>(preset.name.size()),
+                                         addString(preset.body), static_cast<uint32_t>(preset.body.size()),
+                                         static_cast<uint32_t>(sliderRecords.size()),
+                                         static_cast<uint32_t>(preset.sliders.size())});
+
+                const auto& sliders{preset.sliders};
+                std::size_t i{0};
+                sliderNames.ForEachName(sliders.nameIDs, [&](const std::string_view sliderName) {
+                    sliderRecords.push_back({addString(sliderName), static_cast<uint32_t>(sliderName.size()),
+                                             sliders.mins[i], sliders.maxes[i]});
+                    ++i;
+                });
+            }
+        }
+
+        if (strings.size() > std::numeric_limits<uint32_t>::max()) {
+            logger::warn("The presets are too large to be cached.");
+            return;
+        }
+
+        header.sliderCount = static_cast<uint32_t>(sliderRecords.size());
+        header.stringTableSize = static_cast<uint32_t>(strings.size());
+
+        // We write to a temporary file first, so that a crash mid-write never leaves behind a corrupt cache.
+        const std::string temporaryPath{std::string{CachePath} + ".tmp"};
+        bool written;
+        {
+            const stl::FilePtrManager file{temporaryPath.c_str(), "wb"};
+            if (!file.get()) return;
+
+            written = fwrite(&header, sizeof(header), 1, file.get()) == 1 &&
+                      fwrite(presetRecords.data(), sizeof(PresetRecordV1), presetRecords.size(), file.get()) ==
+                          presetRecords.size() &&
+                      fwrite(sliderRecords.data(), sizeof(SliderRecordV1), sliderRecords.size(), file.get()) ==
+                          sliderRecords.size() &&
+                      fwrite(strings.data(), 1, strings.size(), file.get()) == strings.size();
+        }
+
+        std::error_code ec;
+        if (written) fs::rename(temporaryPath, CachePath, ec);
+
+        if (!written || ec) {
+            logger::warn("Failed to write the preset cache.");
+            fs::remove(temporaryPath, ec);
+            return;
+        }
+
+        logger::info("Wrote {} presets to the preset cache.", presetRecords.size());
+    }
+}  // namespace PresetCache
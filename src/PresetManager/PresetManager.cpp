@@ -1,9 +1,14 @@
 #include "PresetManager/PresetManager.h"
 
+#include "Instrumentation/Instrumentation.h"
 #include "JSONParser/JSONParser.h"
+#include "PresetManager/PresetCache.h"
 #include "STL.h"
 
+#include <boost/unordered/unordered_flat_set.hpp>
+
 PresetManager::PresetContainer PresetManager::PresetContainer::instance;
+PresetManager::SliderNameTable PresetManager::SliderNameTable::instance;
 
 namespace PresetManager {
     constexpr auto DefaultSliders =
@@ -12,78 +17,250 @@ namespace PresetManager {
 
     PresetContainer& PresetContainer::GetInstance() { return instance; }
 
-    void GeneratePresets() {
-        const fs::path root_path(R"(Data\CalienteTools\BodySlide\SliderPresets)");
+    SliderNameTable& SliderNameTable::GetInstance() { return instance; }
 
-        auto& container{PresetManager::PresetContainer::GetInstance()};
+    SliderNameID SliderNameTable::Intern(const std::string_view a_name) {
+        // Once the first few presets have been generated, nearly every name is one we've already seen.
+        {
+            std::shared_lock sharedLock{lock};
+            if (const auto itr{idsByName.find(a_name)}; itr != idsByName.end()) return itr->second;
+        }
 
-        auto& femalePresets{container.femalePresets};
-        auto& malePresets{container.malePresets};
+        std::unique_lock uniqueLock{lock};
+        if (const auto itr{idsByName.find(a_name)}; itr != idsByName.end()) return itr->second;
 
-        auto& allFemalePresets{container.allFemalePresets};
-        auto& allMalePresets{container.allMalePresets};
+        const auto id{static_cast<SliderNameID>(names.size())};
+        idsByName.emplace(names.emplace_back(a_name), id);
+        return id;
+    }
 
-        auto& blacklistedFemalePresets{container.blacklistedFemalePresets};
-        auto& blacklistedMalePresets{container.blacklistedMalePresets};
-        auto& parser{Parser::JSONParser::GetInstance()};
-        auto& presetDistributionConfig{parser.presetDistributionConfig};
+    const char* SliderNameTable::GetName(const SliderNameID a_id) const {
+        std::shared_lock sharedLock{lock};
+        return names[a_id].c_str();
+    }
 
-        auto& blacklistedPresets{presetDistributionConfig["blacklistedPresetsFromRandomDistribution"]};
-        stl::RemoveDuplicatesInJsonArray(blacklistedPresets, presetDistributionConfig.GetAllocator());
-        const auto blacklistedPresetsBegin = blacklistedPresets.Begin();
-        const auto blacklistedPresetsEnd = blacklistedPresets.End();
+    void SliderNameTable::GetNames(const std::span<const SliderNameID> a_ids,
+                                   std::vector<const char*>& a_names) const {
+        a_names.resize(a_ids.size());
 
-        for (const auto& entry : fs::directory_iterator(root_path)) {
-            const auto& path{entry.path()};
-            if (path.extension().c_str() != L".xml"sv) continue;
-            if (IsClothedSet(path.wstring())) continue;
+        std::shared_lock sharedLock{lock};
+        for (std::size_t i = 0; i < a_ids.size(); ++i) a_names[i] = names[a_ids[i]].c_str();
+    }
+
+    void PresetSliders::reserve(const std::size_t a_count) {
+        nameIDs.reserve(a_count);
+        mins.reserve(a_count);
+        maxes.reserve(a_count);
+    }
+
+    void PresetSliders::push_back(const SliderNameID a_nameID, const float a_min, const float a_max) {
+        nameIDs.push_back(a_nameID);
+        mins.push_back(a_min);
+        maxes.push_back(a_max);
+    }
+
+    PresetSliders PresetSliders::FromSliderSet(const SliderSet& a_sliderSet) {
+        auto& sliderNames{SliderNameTable::GetInstance()};
+
+        PresetSliders sliders;
+        sliders.reserve(a_sliderSet.size());
+        for (const auto& slider : a_sliderSet | std::views::values) {
+            sliders.push_back(sliderNames.Intern(slider.name), slider.min, slider.max);
+        }
 
+        return sliders;
+    }
+
+    namespace {
+        // What a single SliderPresets file yields, kept per-file so that the files
+        // can be parsed in any order and still be merged in a deterministic one.
+        struct ParsedPresetFile {
+            PresetSet femalePresets;
+            PresetSet malePresets;
+            PresetSet blacklistedFemalePresets;
+            PresetSet blacklistedMalePresets;
+            std::string loadError;
+        };
+
+        void ParsePresetFile(const fs::path& a_path,
+                             const boost::unordered_flat_set<std::string_view>& a_blacklistedPresets,
+                             ParsedPresetFile& a_result) {
             pugi::xml_document doc;
-            if (auto result = doc.load_file(path.c_str(), pugi::parse_default, pugi::encoding_auto); !result) {
-                wchar_t buffer[2048];
-                swprintf_s(buffer, std::size(buffer), L"load failed: %s [%hs]", path.c_str(), result.description());
-                SPDLOG_WARN(buffer);
-                parser.invalid_presets++;
-                continue;
+            if (auto result = doc.load_file(a_path.c_str(), pugi::parse_default, pugi::encoding_auto); !result) {
+                a_result.loadError = result.description();
+                return;
             }
 
-            auto presets = doc.child("SliderPresets");
-            for (const auto& node : presets) {
+            for (const auto& node : doc.child("SliderPresets")) {
                 auto preset = GeneratePreset(node);
                 if (!preset) continue;
 
+                const bool blacklisted{a_blacklistedPresets.contains(preset->name)};
+
                 if (IsFemalePreset(*preset)) {
-                    if (std::find(blacklistedPresetsBegin, blacklistedPresetsEnd, preset.value().name.c_str()) !=
-                        blacklistedPresetsEnd) {
-                        blacklistedFemalePresets.push_back(*preset);
-                    } else {
-                        femalePresets.push_back(*preset);
-                    }
+                    (blacklisted ? a_result.blacklistedFemalePresets : a_result.femalePresets)
+                        .push_back(std::move(*preset));
                 } else {
-                    if (std::find(blacklistedPresetsBegin, blacklistedPresetsEnd, preset.value().name.c_str()) !=
-                        blacklistedPresetsEnd) {
-                        blacklistedMalePresets.push_back(*preset);
-                    } else {
-                        malePresets.push_back(*preset);
+                    (blacklisted ? a_result.blacklistedMalePresets : a_result.malePresets)
+                        .push_back(std::move(*preset));
+                }
+            }
+        }
+
+        void ParsePresetFiles(const std::vector<fs::path>& a_paths,
+                              const boost::unordered_flat_set<std::string_view>& a_blacklistedPresets,
+                              PresetSets& a_presets, std::size_t& a_invalidPresetFiles) {
+            auto& femalePresets{a_presets.femalePresets};
+            auto& malePresets{a_presets.malePresets};
+            auto& blacklistedFemalePresets{a_presets.blacklistedFemalePresets};
+            auto& blacklistedMalePresets{a_presets.blacklistedMalePresets};
+
+            // Reading and parsing the XMLs is by far the most expensive part of this, and every file
+            // is independent of the others, so we spread the files across a handful of workers.
+            // Each worker writes only to its own files' slots, which are then merged in directory order.
+            std::vector<ParsedPresetFile> parsedFiles(a_paths.size());
+            {
+                std::atomic<std::size_t> nextFile{0};
+                auto parseFiles = [&] {
+                    for (auto i{nextFile.fetch_add(1, std::memory_order_relaxed)}; i < a_paths.size();
+                         i = nextFile.fetch_add(1, std::memory_order_relaxed)) {
+                        ParsePresetFile(a_paths[i], a_blacklistedPresets, parsedFiles[i]);
                     }
+                };
+
+                const std::size_t workerCount{
+                    std::min<std::size_t>(std::max(std::thread::hardware_concurrency(), 1u), a_paths.size())};
+
+                // The calling thread is one of the workers; the jthreads join when the scope is left.
+                std::vector<std::jthread> workers;
+                workers.reserve(workerCount > 0 ? workerCount - 1 : 0);
+                for (std::size_t i = 1; i < workerCount; ++i) workers.emplace_back(parseFiles);
+                parseFiles();
+            }
+
+            std::size_t femaleCount{0}, maleCount{0}, blacklistedFemaleCount{0}, blacklistedMaleCount{0};
+            for (const auto& parsedFile : parsedFiles) {
+                femaleCount += parsedFile.femalePresets.size();
+                maleCount += parsedFile.malePresets.size();
+                blacklistedFemaleCount += parsedFile.blacklistedFemalePresets.size();
+                blacklistedMaleCount += parsedFile.blacklistedMalePresets.size();
+            }
+
+            femalePresets.reserve(femalePresets.size() + femaleCount);
+            malePresets.reserve(malePresets.size() + maleCount);
+            blacklistedFemalePresets.reserve(blacklistedFemalePresets.size() + blacklistedFemaleCount);
+            blacklistedMalePresets.reserve(blacklistedMalePresets.size() + blacklistedMaleCount);
+
+            for (std::size_t i = 0; i < parsedFiles.size(); ++i) {
+                auto& parsedFile{parsedFiles[i]};
+
+                if (!parsedFile.loadError.empty()) {
+                    wchar_t buffer[2048];
+                    swprintf_s(buffer, std::size(buffer), L"load failed: %s [%hs]", a_paths[i].c_str(),
+                               parsedFile.loadError.c_str());
+                    SPDLOG_WARN(buffer);
+                    a_invalidPresetFiles++;
+                    continue;
                 }
+
+                std::ranges::move(parsedFile.femalePresets, std::back_inserter(femalePresets));
+                std::ranges::move(parsedFile.malePresets, std::back_inserter(malePresets));
+                std::ranges::move(parsedFile.blacklistedFemalePresets, std::back_inserter(blacklistedFemalePresets));
+                std::ranges::move(parsedFile.blacklistedMalePresets, std::back_inserter(blacklistedMalePresets));
             }
         }
+    }  // namespace
+
+    PresetFiles ListPresetFiles(const rapidjson::Value& a_blacklistedPresets) {
+        const fs::path root_path(R"(Data\CalienteTools\BodySlide\SliderPresets)");
+
+        PresetFiles files;
+        for (const auto& entry : fs::directory_iterator(root_path)) {
+            const auto& path{entry.path()};
+            if (path.extension().c_str() != L".xml"sv) continue;
+            if (IsClothedSet(path.wstring())) continue;
+
+            files.paths.push_back(path);
+        }
+
+        files.fingerprint = PresetCache::ComputeFingerprint(files.paths, a_blacklistedPresets);
+
+        return files;
+    }
+
+    PresetSets LoadPresets(const PresetFiles& a_files, const rapidjson::Value& a_blacklistedPresets,
+                           std::size_t& a_invalidPresetFiles) {
+        [[maybe_unused]] stl::timeit const t;
+
+        PresetSets presets;
+        if (!PresetCache::Load(a_files.fingerprint, presets, a_invalidPresetFiles)) {
+            presets = ParsePresets(a_files, a_blacklistedPresets, a_invalidPresetFiles);
+            PresetCache::Save(a_files.fingerprint, presets, a_invalidPresetFiles);
+        }
+
+        return presets;
+    }
+
+    PresetSets ParsePresets(const PresetFiles& a_files, const rapidjson::Value& a_blacklistedPresets,
+                            std::size_t& a_invalidPresetFiles) {
+        // The names view the strings of the config, which outlive this function.
+        boost::unordered_flat_set<std::string_view> blacklistedPresetNames;
+        blacklistedPresetNames.reserve(a_blacklistedPresets.Size());
+        for (const auto& presetName : a_blacklistedPresets.GetArray()) {
+            blacklistedPresetNames.emplace(presetName.GetString(), presetName.GetStringLength());
+        }
+
+        PresetSets presets;
+        ParsePresetFiles(a_files.paths, blacklistedPresetNames, presets, a_invalidPresetFiles);
+
+        return presets;
+    }
+
+    void GeneratePresets() {
+        [[maybe_unused]] stl::timeit const t;
+
+        auto& container{PresetManager::PresetContainer::GetInstance()};
+        auto& parser{Parser::JSONParser::GetInstance()};
+        auto& presetDistributionConfig{parser.presetDistributionConfig};
+
+        auto& blacklistedPresets{presetDistributionConfig["blacklistedPresetsFromRandomDistribution"]};
+        stl::RemoveDuplicatesInJsonArray(blacklistedPresets, presetDistributionConfig.GetAllocator());
+
+        const auto files{ListPresetFiles(blacklistedPresets)};
+        container.ReplacePresets(LoadPresets(files, blacklistedPresets, parser.invalid_presets), files.fingerprint);
+
+        logger::info("Female presets: {}, Male presets: {}", container.femalePresets.size(),
+                     container.malePresets.size());
+        logger::info("Blacklisted: Female presets: {}, Male Presets: {}", container.blacklistedFemalePresets.size(),
+                     container.blacklistedMalePresets.size());
+    }
+
+    void PresetContainer::ReplacePresets(PresetSets&& a_presets, const uint64_t a_fingerprint) {
+        femalePresets = std::move(a_presets.femalePresets);
+        malePresets = std::move(a_presets.malePresets);
+        blacklistedFemalePresets = std::move(a_presets.blacklistedFemalePresets);
+        blacklistedMalePresets = std::move(a_presets.blacklistedMalePresets);
+        presetFilesFingerprint = a_fingerprint;
+        revision.fetch_add(1, std::memory_order_release);
+
         // For performance reasons, PresetContainer::AssignPresetIndexes
         // relies on the blacklisted presets coming after the non-blacklisted presets.
         // (In order to not rely on this order, we'd instead have to perform string-key lookups
         //  via a hash-table, instead of direct array access. Which wouldn't be good for code
         //  that runs every time a saved-game is loaded).
 
-        allFemalePresets = femalePresets;
+        allFemalePresets.clear();
+        allFemalePresets.reserve(femalePresets.size() + blacklistedFemalePresets.size());
+        allFemalePresets.insert_range(allFemalePresets.end(), femalePresets);
         allFemalePresets.insert_range(allFemalePresets.end(), blacklistedFemalePresets);
 
-        allMalePresets = malePresets;
+        allMalePresets.clear();
+        allMalePresets.reserve(malePresets.size() + blacklistedMalePresets.size());
+        allMalePresets.insert_range(allMalePresets.end(), malePresets);
         allMalePresets.insert_range(allMalePresets.end(), blacklistedMalePresets);
 
-        logger::info("Female presets: {}, Male presets: {}", femalePresets.size(), malePresets.size());
-        logger::info("Blacklisted: Female presets: {}, Male Presets: {}", blacklistedFemalePresets.size(),
-                     blacklistedMalePresets.size());
+        IndexPresetsByName();
+        SortPresetNames();
     }
 
     std::optional<Preset> GeneratePreset(const pugi::xml_node& a_node) {
@@ -93,58 +270,112 @@ namespace PresetManager {
 
         const std::string_view body{a_node.attribute("set").value()};
 
-        return Preset{name.data(), body.data(), SliderSetFromNode(a_node, GetBodyType(body))};
+        return Preset{name.data(), body.data(),
+                      PresetSliders::FromSliderSet(SliderSetFromNode(a_node, GetBodyType(body)))};
     }
 
-    void PresetContainer::AssignPresetIndexes() {
-        auto assignIndexes = [&](PresetSet& allLoadedPresets, PresetSet& nonBlacklistedPresets,
-                                 PresetSet& blacklistedPresets, auto& presetIndexMap, auto& sparseIndexMap,
-                                 auto& nextPresetIndex) {
-            assert(allLoadedPresets.size() == nonBlacklistedPresets.size() + blacklistedPresets.size());
+    void AssignPresetIndexesForSex(PresetSet& a_allPresets, PresetSet& a_presets, PresetSet& a_blacklistedPresets,
+                                   boost::unordered_flat_map<std::string, AssignedPresetIndex>& a_presetIndexByName,
+                                   SparsePresetMapping& a_presetsByIndex, AssignedPresetIndex& a_nextPresetIndex) {
+        assert(a_allPresets.size() == a_presets.size() + a_blacklistedPresets.size());
 
-            // We ensure that absent presets have an index of -1 to signify their absence.
-            sparseIndexMap.resize(0);
-            sparseIndexMap.resize(nextPresetIndex.value, -1);
+        // First, we find each loaded preset's index, handing out new ones to the names we haven't seen before.
+        // At most every loaded preset is new, so the map grows no more than the once.
+        a_presetIndexByName.reserve(a_presetIndexByName.size() + a_allPresets.size());
 
-            size_t loadedIndexOffset = 0;
+        for (auto& preset : a_allPresets) {
+            auto indexAssignment = a_presetIndexByName.emplace(preset.name, a_nextPresetIndex.value);
 
-            auto assignSubset = [&](PresetSet& subset) {
-                size_t loadedIndex = 0;
+            if (indexAssignment.second) {
+                // This is a preset name we haven't seen before.
+                ++a_nextPresetIndex.value;
+            }
 
-                for (; loadedIndex < subset.size(); ++loadedIndex) {
-                    auto& presetInSubset = subset[loadedIndex];
-                    auto& presetInAll = allLoadedPresets[loadedIndexOffset + loadedIndex];
+            preset.assignedIndex = indexAssignment.first->second;
+        }
 
-                    assert(presetInSubset.name == presetInAll.name);
+        // Then, now that we know how many indexes there are, we map them to the loaded presets in one go.
+        // We ensure that absent presets have an index of -1 to signify their absence.
+        a_presetsByIndex.assign(a_nextPresetIndex.value, static_cast<SparsePresetIndex>(-1));
 
-                    auto indexAssignment = presetIndexMap.emplace(presetInSubset.name, nextPresetIndex.value);
+        for (size_t loadedIndex = 0; loadedIndex < a_allPresets.size(); ++loadedIndex) {
+            a_presetsByIndex[a_allPresets[loadedIndex].assignedIndex.value] =
+                static_cast<SparsePresetIndex>(loadedIndex);
+        }
 
-                    if (indexAssignment.second) {
-                        // This is a preset name we haven't seen before.
-                        ++nextPresetIndex.value;
-                        sparseIndexMap.resize(nextPresetIndex.value);
-                    }
+        // The subsets are in the same order as the set of all presets, the non-blacklisted ones coming first.
+        for (size_t loadedIndex = 0; loadedIndex < a_presets.size(); ++loadedIndex) {
+            assert(a_presets[loadedIndex].name == a_allPresets[loadedIndex].name);
+            a_presets[loadedIndex].assignedIndex = a_allPresets[loadedIndex].assignedIndex;
+        }
 
-                    auto assignedIndex = indexAssignment.first->second;
-                    sparseIndexMap[assignedIndex.value] = loadedIndexOffset + loadedIndex;
+        const auto blacklistedOffset{a_presets.size()};
+        for (size_t loadedIndex = 0; loadedIndex < a_blacklistedPresets.size(); ++loadedIndex) {
+            auto& presetInAll = a_allPresets[blacklistedOffset + loadedIndex];
 
-                    presetInSubset.assignedIndex = assignedIndex;
-                    presetInAll.assignedIndex = assignedIndex;
-                }
+            assert(a_blacklistedPresets[loadedIndex].name == presetInAll.name);
+            a_blacklistedPresets[loadedIndex].assignedIndex = presetInAll.assignedIndex;
+        }
+    }
+
+    void PresetContainer::AssignPresetIndexes() {
+        [[maybe_unused]] stl::timeit const t;
+
+        // The sexes share nothing, so the male presets are indexed on another thread while we do the female ones.
+        {
+            std::jthread maleWorker{[&] {
+                AssignPresetIndexesForSex(this->allMalePresets, this->malePresets, this->blacklistedMalePresets,
+                                          this->malePresetIndexByName, this->allMalePresetsByIndex,
+                                          this->nextMalePresetIndex);
+            }};
+
+            AssignPresetIndexesForSex(this->allFemalePresets, this->femalePresets, this->blacklistedFemalePresets,
+                                      this->femalePresetIndexByName, this->allFemalePresetsByIndex,
+                                      this->nextFemalePresetIndex);
+        }
+
+        logger::info("Assigned indexes to all the loaded presets: {} female and {} male preset names are known.",
+                     nextFemalePresetIndex.value, nextMalePresetIndex.value);
+    }
 
-                loadedIndexOffset += loadedIndex;
-            };
+    void PresetContainer::IndexPresetsByName() {
+        auto indexByName = [](const PresetSet& presets, auto& presetsByName) {
+            presetsByName.clear();
+            presetsByName.reserve(presets.size());
 
-            assignSubset(nonBlacklistedPresets);
-            assignSubset(blacklistedPresets);
+            for (uint32_t denseIndex = 0; denseIndex < presets.size(); ++denseIndex) {
+                // Should presets share a name, the first one wins, as it did when these lookups were linear.
+                presetsByName.emplace(presets[denseIndex].name, denseIndex);
+            }
         };
 
-        assignIndexes(this->allFemalePresets, this->femalePresets, this->blacklistedFemalePresets,
-                      this->femalePresetIndexByName, this->allFemalePresetsByIndex, this->nextFemalePresetIndex);
-        assignIndexes(this->allMalePresets, this->malePresets, this->blacklistedMalePresets,
-                      this->malePresetIndexByName, this->allMalePresetsByIndex, this->nextMalePresetIndex);
+        indexByName(this->allFemalePresets, this->allFemalePresetsByName);
+        indexByName(this->allMalePresets, this->allMalePresetsByName);
+    }
+
+    void PresetContainer::SortPresetNames() {
+        auto sortNames = [](const PresetSet& presets, std::vector<std::string_view>& sortedNames) {
+            sortedNames.clear();
+            sortedNames.reserve(presets.size());
+            std::ranges::transform(presets, std::back_inserter(sortedNames),
+                                   [](const Preset& a_preset) { return std::string_view{a_preset.name}; });
+            std::ranges::sort(sortedNames, stl::iless{});
+        };
 
-        logger::info("Assigned indexes to all the loaded presets.");
+        sortNames(this->femalePresets, this->sortedFemalePresetNames);
+        sortNames(this->malePresets, this->sortedMalePresetNames);
+        sortNames(this->allFemalePresets, this->sortedAllFemalePresetNames);
+        sortNames(this->allMalePresets, this->sortedAllMalePresetNames);
+    }
+
+    const Preset* PresetContainer::FindPresetByName(const std::string_view a_name, const bool female) const {
+        const auto& presetsByName{female ? allFemalePresetsByName : allMalePresetsByName};
+
+        if (const auto itr{presetsByName.find(a_name)}; itr != presetsByName.end()) {
+            return &(female ? allFemalePresets : allMalePresets)[itr->second];
+        }
+
+        return nullptr;
     }
 
     Preset* AssignedPresetIndex::GetPreset(bool actorIsFemale) const {
@@ -178,58 +409,31 @@ namespace PresetManager {
         return {};
     }
 
-    Preset GetPresetByName(const PresetSet& a_presetSet, const std::string_view a_name, const bool female) {
-        logger::info("Looking for preset: {}", a_name);
-
-        for (auto& preset : a_presetSet) {
-            if (stl::cmp(preset.name, a_name)) return preset;
-        }
+    const Preset* GetPresetByName(const std::string_view a_name, const bool female) {
+        OBODY_ACTOR_LOG("Looking for preset: {}", a_name);
 
-        logger::info("Preset not found, choosing a random one.");
         const auto& container{PresetManager::PresetContainer::GetInstance()};
-        return GetRandomPreset(female ? container.femalePresets : container.malePresets);
-    }
 
-    Preset GetRandomPreset(const PresetSet& a_presetSet) {
-        static_assert(std::is_same_v<decltype(0llu), decltype(a_presetSet.size())>,
-                      "Ensure that below literal is of type std::size_t");
-        return a_presetSet[stl::random(0llu, a_presetSet.size())];
-    }
-
-    std::optional<Preset> GetPresetByNameForRandom(const PresetSet& a_presetSet, const std::string_view a_name) {
-        logger::info("Looking for preset: {}", a_name);
+        if (const auto* preset{container.FindPresetByName(a_name, female)}) return preset;
 
-        for (const auto& preset : a_presetSet) {
-            if (stl::cmp(preset.name, a_name)) {
-                return preset;
-            }
-        }
-
-        return {};
+        OBODY_ACTOR_LOG("Preset not found, choosing a random one.");
+        return GetRandomPreset(female ? container.femalePresets : container.malePresets);
     }
 
-    std::optional<Preset> GetRandomPresetByName(const PresetSet& a_presetSet, std::vector<std::string_view> a_presetNames,
-                                 const bool female) {
-        if (a_presetNames.empty()) {
-            logger::info("Preset names size is empty, returning none");
-            return std::nullopt;
+    const Preset* GetRandomPreset(const PresetSet& a_presetSet) {
+        if (a_presetSet.empty()) {
+            return nullptr;
         }
 
-        static_assert(std::is_same_v<decltype(0llu), decltype(a_presetNames.size())>,
+        static_assert(std::is_same_v<decltype(0llu), decltype(a_presetSet.size())>,
                       "Ensure that below literal is of type std::size_t");
-        const std::string_view chosenPreset{a_presetNames[stl::random(0llu, a_presetNames.size())]};
-
-        const std::optional<Preset> preset{GetPresetByNameForRandom(a_presetSet, chosenPreset)};
-
-        if (!preset.has_value()) {
-            if (const auto iterator{std::ranges::find(a_presetNames, chosenPreset)}; iterator != a_presetNames.end()) {
-                a_presetNames.erase(iterator);
-            }
+        return &a_presetSet[stl::random(0llu, a_presetSet.size())];
+    }
 
-            return GetRandomPresetByName(a_presetSet, a_presetNames, female);
-        }
+    const Preset* GetPresetByNameForRandom(const std::string_view a_name, const bool female) {
+        OBODY_ACTOR_LOG("Looking for preset: {}", a_name);
 
-        return *preset;
+        return PresetContainer::GetInstance().FindPresetByName(a_name, female);
     }
 
     bool IsFemalePreset(const Preset& a_preset) {
@@ -0,0 +1,336 @@
+#include "Reload/Reload.h"
+
+#include "ActorTracker/ActorTracker.h"
+#include "Body/Body.h"
+#include "JSONParser/ConfigFile.h"
+#include "JSONParser/ConfigValidationCache.h"
+#include "JSONParser/JSONParser.h"
+#include "PresetManager/PresetManager.h"
+#include "STL.h"
+
+namespace Reload {
+    namespace {
+        std::atomic<bool> reloading{false};
+
+        // See `ReadGuard`.
+        std::shared_mutex replacementLock;
+        thread_local uint32_t readGuardDepth{0};
+
+        // What was read from the files that changed, ready to take the place of what's in use.
+        struct StagedReload {
+            // Null should the config be unchanged.
+            std::unique_ptr<rapidjson::Document> config;
+            uint64_t configFingerprint = 0;
+            // Empty should the presets be unchanged.
+            std::optional<PresetManager::PresetSets> presets;
+            uint64_t presetFilesFingerprint = 0;
+            std::size_t invalidPresetFiles = 0;
+        };
+
+        // Runs off the main thread. The config in use is only read here when it's unchanged,
+        // and nothing but a reload, of which there's only ever the one, writes to it once the game is running.
+        bool Stage(StagedReload& a_staged) {
+            [[maybe_unused]] stl::timeit const t;
+
+            auto& parser{Parser::JSONParser::GetInstance()};
+
+            const auto schemaJson{ConfigFile::Read(ConfigFile::SchemaPath)};
+            const auto configJson{ConfigFile::Read(ConfigFile::ConfigPath)};
+            if (!schemaJson || !configJson) {
+                logger::error("Unable to read OBody_presetDistributionConfig.json, or its schema");
+                return false;
+            }
+
+            a_staged.configFingerprint = ConfigValidationCache::ComputeFingerprint(*configJson, *schemaJson);
+            if (a_staged.configFingerprint != parser.presetDistributionConfigFingerprint) {
+                auto config{std::make_unique<rapidjson::Document>()};
+                if (ConfigFile::Parse(*config, *configJson).HasParseError()) {
+                    logger::error("Config Error(offset {}): {}", config->GetErrorOffset(),
+                                  rapidjson::GetParseError_En(config->GetParseError()));
+                    return false;
+                }
+
+                if (!ConfigValidationCache::IsValidated(a_staged.configFingerprint)) {
+                    if (!ConfigFile::Validate(*config, *schemaJson)) return false;
+                    ConfigValidationCache::SaveValidated(a_staged.configFingerprint);
+                }
+
+                auto& blacklistedPresets{(*config)["blacklistedPresetsFromRandomDistribution"]};
+                stl::RemoveDuplicatesInJsonArray(blacklistedPresets, config->GetAllocator());
+
+                a_staged.config = std::move(config);
+                logger::info("OBody_presetDistributionConfig.json has changed, and will be reloaded");
+            }
+
+            auto& config{a_staged.config ? *a_staged.config : parser.presetDistributionConfig};
+            const auto& blacklistedPresets{config["blacklistedPresetsFromRandomDistribution"]};
+
+            const auto files{PresetManager::ListPresetFiles(blacklistedPresets)};
+            a_staged.presetFilesFingerprint = files.fingerprint;
+            if (files.fingerprint != PresetManager::PresetContainer::GetInstance().presetFilesFingerprint) {
+                a_staged.presets = PresetManager::LoadPresets(files, blacklistedPresets, a_staged.invalidPresetFiles);
+                logger::info("The BodySlide presets have changed, and have been reloaded");
+            }
+
+            return true;
+        }
+
+        // What the rules decide for an actor, as far as whether their body still fits goes.
+        struct Decision {
+            bool blacklisted = false;
+            // Null when the preset is to be picked from the random pool.
+            const Parser::CompiledRules::PresetList* presets = nullptr;
+        };
+
+        Decision Decide(RE::Actor* a_actor, const bool a_female) {
+            auto& parser{Parser::JSONParser::GetInstance()};
+
+            using Outcome = Parser::DistributionDecision::Outcome;
+            const auto decision{parser.GetDistributionDecision(a_actor->GetActorBase(), a_female)};
+
+            if (decision.outcome == Outcome::Blacklisted ||
+                (decision.outcome == Outcome::DistributedPresets && parser.IsNPCPluginBlacklisted(a_actor, a_female))) {
+                return {true};
+            }
+
+            // An empty list has the preset picked from the random pool too.
+            return {false, decision.presets && !decision.presets->empty() ? decision.presets : nullptr};
+        }
+
+        // Where an actor's preset comes from, so that a list naming the same presets as the random pool
+        // doesn't pass for the random pool.
+        enum class PresetSource : uint8_t { kNone, kList, kRandomPool };
+
+        template <typename Presets, typename Projection>
+        uint64_t SignPresetNames(const PresetSource a_source, const Presets& a_presets, Projection&& a_projection) {
+            stl::Fingerprinter fingerprint;
+            fingerprint.Add(a_source);
+            for (const auto& preset : a_presets) {
+                const std::string& name{a_projection(preset)};
+                fingerprint.Add(name.size());
+                fingerprint.Add(name.data(), name.size());
+            }
+
+            return fingerprint.hash;
+        }
+
+        // The presets are replaced by a reload, so decisions are compared by the names of their presets.
+        struct RandomPoolSignatures {
+            uint64_t female;
+            uint64_t male;
+
+            static RandomPoolSignatures Sign() {
+                const auto& presetContainer{PresetManager::PresetContainer::GetInstance()};
+                auto name = [](const PresetManager::Preset& a_preset) -> const std::string& { return a_preset.name; };
+                return {SignPresetNames(PresetSource::kRandomPool, presetContainer.femalePresets, name),
+                        SignPresetNames(PresetSource::kRandomPool, presetContainer.malePresets, name)};
+            }
+        };
+
+        uint64_t Sign(const Decision& a_decision, const bool a_female, const RandomPoolSignatures& a_randomPools) {
+            if (a_decision.blacklisted) {
+                stl::Fingerprinter fingerprint;
+                fingerprint.Add(PresetSource::kNone);
+                return fingerprint.hash;
+            }
+
+            if (!a_decision.presets) return a_female ? a_randomPools.female : a_randomPools.male;
+
+            return SignPresetNames(PresetSource::kList, *a_decision.presets,
+                                   [](const PresetManager::Preset* a_preset) -> const std::string& {
+                                       return a_preset->name;
+                                   });
+        }
+
+        // Whether the actor's body no longer fits what the rules decide for them,
+        // their preset being one the rules would no longer pick.
+        bool NoLongerFits(RE::Actor* a_actor, const bool a_female, const Decision& a_decision) {
+            const auto& obody{Body::OBody::GetInstance()};
+            if (a_decision.blacklisted != obody.IsBlacklisted(a_actor)) return true;
+            if (a_decision.blacklisted) return false;
+
+            uint32_t actorPresetIndex = 0;
+            ActorTracker::Registry::GetInstance().stateForActor.cvisit(
+                a_actor->formID, [&](auto& entry) { actorPresetIndex = entry.second.presetIndex; });
+
+            // Minus one because an index of zero assigned to the actor signifies the absence of a preset.
+            const PresetManager::AssignedPresetIndex presetIndex{actorPresetIndex - 1};
+            const auto* preset{actorPresetIndex != 0 ? presetIndex.GetPreset(a_female) : nullptr};
+            if (!preset) return true;
+
+            if (a_decision.presets) return !std::ranges::contains(*a_decision.presets, preset);
+
+            const auto& presetContainer{PresetManager::PresetContainer::GetInstance()};
+            const auto& randomPool{a_female ? presetContainer.femalePresets : presetContainer.malePresets};
+            return std::ranges::none_of(randomPool, [&](const auto& a_pick) { return a_pick.name == preset->name; });
+        }
+
+        struct TrackedActor {
+            RE::NiPointer<RE::Actor> actor;
+            bool female;
+            uint64_t signature;
+        };
+
+        // The same actors that RegenerateLoadedActors regenerates, bar those that are yet to be processed,
+        // who'll be generated by the new rules anyway.
+        std::vector<TrackedActor> TrackLoadedActors() {
+            std::vector<TrackedActor> trackedActors;
+
+            const auto* processLists{RE::ProcessLists::GetSingleton()};
+            if (!processLists) return trackedActors;
+
+            const auto& obody{Body::OBody::GetInstance()};
+            const auto randomPools{RandomPoolSignatures::Sign()};
+
+            for (const auto& actorHandle : processLists->highActorHandles) {
+                auto actor{actorHandle.get()};
+                if (!actor || !actor->Is3DLoaded() || !actor->HasKeywordString("ActorTypeNPC") || actor->IsChild()) {
+                    continue;
+                }
+
+                if (!obody.IsProcessed(actor.get())) continue;
+
+                const bool female{Body::OBody::IsFemale(actor.get())};
+                const auto signature{Sign(Decide(actor.get(), female), female, randomPools)};
+                trackedActors.emplace_back(std::move(actor), female, signature);
+            }
+
+            return trackedActors;
+        }
+
+        void Finish(const bool a_succeeded, const std::size_t a_regenerated, const OnComplete& a_onComplete) {
+            if (a_succeeded) {
+                logger::info("Reloaded the config, regenerating {} loaded actors", a_regenerated);
+            } else {
+                logger::error("Unable to reload the config, the config and presets in use stay in use");
+            }
+
+            reloading.store(false, std::memory_order_release);
+
+            if (auto* evSrc = SKSE::GetModCallbackEventSource()) {
+                SKSE::ModCallbackEvent ev{};
+                ev.eventName = "OBody_ConfigReloaded";
+                ev.numArg = a_succeeded ? static_cast<float>(a_regenerated) : -1.0F;
+                evSrc->SendEvent(&ev);
+            }
+
+            if (a_onComplete) a_onComplete(a_succeeded, a_regenerated);
+        }
+
+        // Runs on the main thread, in a single task, so nothing there sees the rules or the presets halfway replaced,
+        // and the plugin-API's readers on other threads are kept out by the replacement lock while they're replaced.
+        void Apply(StagedReload& a_staged, ::OBody::API::IPluginInterface* responsibleInterface,
+                   OnComplete a_onComplete) {
+            [[maybe_unused]] stl::timeit const t;
+
+            if (!a_staged.config && !a_staged.presets) {
+                logger::info("Neither the config nor the presets have changed, so there's nothing to reload");
+                Finish(true, 0, a_onComplete);
+                return;
+            }
+
+            auto& obody{Body::OBody::GetInstance()};
+            auto& parser{Parser::JSONParser::GetInstance()};
+            auto& presetContainer{PresetManager::PresetContainer::GetInstance()};
+
+            auto trackedActors{TrackLoadedActors()};
+
+            // The names of the presets are only guaranteed to plugins for as long as OBody is ready,
+            // so OBody is unready while the presets are replaced.
+            bool wasReady{false};
+            if (a_staged.presets) {
+                logger::info("Becoming unready for plugin-API usage.");
+                wasReady = obody.BecomingUnreadyForPluginAPIUsage();
+                if (wasReady) obody.NoLongerReadyForPluginAPIUsage();
+            }
+
+            std::unique_lock replacementGuard{replacementLock};
+
+            if (a_staged.config) {
+                parser.presetDistributionConfig.Swap(*a_staged.config);
+                parser.presetDistributionConfigFingerprint = a_staged.configFingerprint;
+                parser.ProcessJSONCategories();
+            }
+
+            if (a_staged.presets) {
+                presetContainer.ReplacePresets(std::move(*a_staged.presets), a_staged.presetFilesFingerprint);
+                parser.invalid_presets = a_staged.invalidPresetFiles;
+                parser.bodyslidePresetsParsingValid = true;
+
+                // The presets seen before keep their indexes, as the indexes by name are kept,
+                // and so the actors keep their presets.
+                presetContainer.AssignPresetIndexes();
+            }
+
+            // The rules refer to the presets directly, so they're compiled again whichever changed.
+            parser.CompileRules();
+
+            replacementGuard.unlock();
+
+            if (wasReady) {
+                logger::info("Becoming ready for plugin-API usage.");
+                if (obody.BecomingReadyForPluginAPIUsage()) obody.ReadyForPluginAPIUsage();
+            }
+
+            const auto randomPools{RandomPoolSignatures::Sign()};
+            std::vector<RE::NiPointer<RE::Actor>> actorsToRegenerate;
+            for (auto& trackedActor : trackedActors) {
+                auto* actor{trackedActor.actor.get()};
+                const auto decision{Decide(actor, trackedActor.female)};
+
+                if (Sign(decision, trackedActor.female, randomPools) == trackedActor.signature) continue;
+                if (!NoLongerFits(actor, trackedActor.female, decision)) continue;
+
+                actorsToRegenerate.push_back(std::move(trackedActor.actor));
+            }
+
+            logger::info("{} of {} loaded actors no longer fit the rules", actorsToRegenerate.size(),
+                         trackedActors.size());
+
+            obody.RegenerateActors(std::move(actorsToRegenerate), responsibleInterface,
+                                   [onComplete = std::move(a_onComplete)](const std::size_t a_regenerated) {
+                                       Finish(true, a_regenerated, onComplete);
+                                   });
+        }
+    }  // namespace
+
+    ReadGuard::ReadGuard() {
+        if (readGuardDepth++ == 0) replacementLock.lock_shared();
+    }
+
+    ReadGuard::~ReadGuard() {
+        if (--readGuardDepth == 0) replacementLock.unlock_shared();
+    }
+
+    bool Request(::OBody::API::IPluginInterface* responsibleInterface, OnComplete a_onComplete) {
+        // Until then, the game's data, or the save's preset indexes, may not be loaded.
+        if (!Body::OBody::GetInstance().readyForPluginAPIUsage) return false;
+        if (reloading.exchange(true, std::memory_order_acquire)) return false;
+
+        logger::info("Reloading the config");
+
+        std::thread([responsibleInterface, onComplete = std::move(a_onComplete)]() mutable {
+            auto staged{std::make_shared<StagedReload>()};
+
+            bool staging{false};
+            try {
+                staging = Stage(*staged);
+            } catch (const std::exception& ex) {
+                logger::error("{}", ex.what());
+            } catch (...) {
+                logger::error("An unknown error has occurred while reloading the config.");
+            }
+
+            SKSE::GetTaskInterface()->AddTask(
+                [staged, staging, responsibleInterface, onComplete = std::move(onComplete)]() mutable {
+                    if (staging) {
+                        Apply(*staged, responsibleInterface, std::move(onComplete));
+                    } else {
+                        Finish(false, 0, onComplete);
+                    }
+                });
+        }).detach();
+
+        return true;
+    }
+}  // namespace Reload
@@ -1,5 +1,7 @@
 #include "SaveFileState/SaveFileState.h"
 
+#include "Instrumentation/Instrumentation.h"
+
 #pragma push_macro("max")
 #pragma push_macro("min")
 #undef max
@@ -8,10 +10,18 @@ namespace SaveFileState {
     // Refer to https://github.com/Ryan-rsm-McKenzie/CommonLibSSE/wiki/Serialization
 
     void SaveState(SKSE::SerializationInterface* save) {
+        // Saving is as good a time as any to take stock of where the frame time went.
+        Instrumentation::Dump(spdlog::level::debug);
+
+        Instrumentation::ScopedTimer const timer{Instrumentation::Stage::CosaveWrite};
+
         Buffer buffer;
 
-        if (save->OpenRecord(ActorRegistryTypeID, 0)) {
-            if (!WriteRecordDataForActorRegistryV0(save, buffer, ActorTracker::Registry::GetInstance())) {
+        // There's no point in saving what nothing would miss.
+        ActorTracker::Registry::GetInstance().CollectGarbage();
+
+        if (save->OpenRecord(ActorRegistryTypeID, 1)) {
+            if (!WriteRecordDataForActorRegistryV1(save, buffer, ActorTracker::Registry::GetInstance())) {
                 logger::critical("Failed to save the actor-registry!");
             }
         } else {
@@ -37,6 +47,8 @@ namespace SaveFileState {
     }
 
     void LoadState(SKSE::SerializationInterface* load) {
+        Instrumentation::ScopedTimer const timer{Instrumentation::Stage::CosaveRead};
+
         Buffer buffer;
 
         size_t actorRegistryCount = 0;
@@ -53,7 +65,16 @@ namespace SaveFileState {
                     switch (version) {
                         case 0: {
                             if (++actorRegistryCount == 1) {
-                                if (!ReadRecordDataForActorRegistryV0(load, buffer,
+                                if (!ReadRecordDataForActorRegistryV0(load, buffer, length,
+                                                                      ActorTracker::Registry::GetInstance())) {
+                                    logger::critical("Failed to load the actor-registry!");
+                                }
+                            }
+                            break;
+                        }
+                        case 1: {
+                            if (++actorRegistryCount == 1) {
+                                if (!ReadRecordDataForActorRegistryV1(load, buffer, length,
                                                                       ActorTracker::Registry::GetInstance())) {
                                     logger::critical("Failed to load the actor-registry!");
                                 }
@@ -135,6 +156,7 @@ namespace SaveFileState {
     void RevertState([[maybe_unused]] SKSE::SerializationInterface* revert) {
         auto& registry = ActorTracker::Registry::GetInstance();
         registry.stateForActor.clear();
+        registry.oRefitBaselineForActor.clear();
 
         auto& presetContainer = PresetManager::PresetContainer::GetInstance();
         presetContainer.femalePresetIndexByName.clear();
@@ -156,13 +178,16 @@ namespace SaveFileState {
         size_t offset = 0;
 
         bool succeeded = registry.stateForActor.cvisit_while([&](const auto& entry) {
+            ActorTracker::ActorState actorState = entry.second;
+            actorState.value = actorState.value & ActorTracker::ActorState::PersistedInCosaveMask;
+
+            // Actors that are only in the registry for their morph flags have nothing worth saving.
+            if (actorState.value == 0) return true;
+
             RE::FormID formID = entry.first;
             std::memcpy(&buffer[offset], &formID, sizeof(decltype(formID)));
             offset += sizeof(decltype(formID));
 
-            ActorTracker::ActorState actorState = entry.second;
-            actorState.value = actorState.value & ActorTracker::ActorState::PersistedInCosaveMask;
-
             std::memcpy(&buffer[offset], &actorState, sizeof(decltype(actorState)));
             offset += sizeof(decltype(actorState));
 
@@ -183,9 +208,13 @@ namespace SaveFileState {
         return succeeded;
     }
 
-    bool ReadRecordDataForActorRegistryV0(SKSE::SerializationInterface* load, Buffer buffer,
+    bool ReadRecordDataForActorRegistryV0(SKSE::SerializationInterface* load, Buffer buffer, const uint32_t length,
                                           ActorTracker::Registry& registry) {
         // See `WriteRecordDataForActorRegistryV0` for a description of this format.
+        // Each entry is of a fixed size, so we know how many there are from the record's length.
+        LoadedActorStates actorStates;
+        actorStates.reserve(length / (sizeof(RE::FormID) + sizeof(ActorTracker::ActorState)));
+
         size_t offset{};
         size_t remainingBytes = 0;
 
@@ -195,12 +224,15 @@ namespace SaveFileState {
 
                 if (remainingBytes == 0) {
                     // We've reached the end of the data--we're done.
+                    InsertLoadedActorStates(std::move(actorStates), registry);
                     return true;
                 }
 
                 if (!IsAlignedTo(remainingBytes, sizeof(RE::FormID) + sizeof(ActorTracker::ActorState))) {
                     logger::critical("This save file's actor-registry is misaligned! {{remainingBytes: {}}}",
                                      remainingBytes);
+                    // We keep what we could read, as we did when we inserted the entries as we read them.
+                    InsertLoadedActorStates(std::move(actorStates), registry);
                     return false;
                 }
 
@@ -219,13 +251,245 @@ namespace SaveFileState {
 
             if (load->ResolveFormID(formID, formID)) {
                 actorState.value = actorState.value & ActorTracker::ActorState::PersistedInCosaveMask;
-                registry.stateForActor.insert_or_assign(formID, actorState);
+                actorStates.emplace_back(formID, actorState);
             }
         }
 
         assert(false);
     }
 
+    template <typename Serializer>
+    bool WriteRecordDataForActorRegistryV1(Serializer* save, Buffer buffer, const ActorTracker::Registry& registry) {
+        // Most of the registry is made of actors from the same few plugins, whose form-IDs are close together,
+        // and most of whom are assigned one of a handful of presets, so this format stores them as such:
+        // The entries are grouped by the plugin they belong to, and sorted by persisted actor-state, then form-ID,
+        // within each group, so that the actors sharing a preset make up a single run rather than many short ones.
+        // Each group begins with the plugin's base form-ID (see `GetPluginBaseOfFormID`) and its count of runs,
+        // where a run is a sequence of entries sharing the same persisted actor-state.
+        // Each run begins with its count of entries and their persisted actor-state, shifted down to its lowest
+        // bits, followed by the difference between each entry's form-ID and the one that came before it
+        // (or the plugin's base form-ID, for the run's first entry).
+        // Every one of those integers is stored as an unsigned LEB128 varint, and the groups run to the end
+        // of the record.
+        using ActorState = ActorTracker::ActorState;
+        constexpr auto persistedShift{std::countr_zero(ActorState::PersistedInCosaveMask)};
+
+        std::vector<std::pair<RE::FormID, uint32_t>> entries;
+        entries.reserve(registry.stateForActor.size());
+
+        registry.stateForActor.cvisit_all([&](const auto& entry) {
+            const uint32_t persistedState{(entry.second.value & ActorState::PersistedInCosaveMask) >> persistedShift};
+
+            // Actors that are only in the registry for their morph flags have nothing worth saving.
+            if (persistedState != 0) entries.emplace_back(entry.first, persistedState);
+        });
+
+        std::ranges::sort(entries, {}, [](const auto& entry) {
+            return std::tuple{GetPluginBaseOfFormID(entry.first), entry.second, entry.first};
+        });
+
+        size_t offset = 0;
+
+        auto writeVarint = [&](uint32_t value) -> bool {
+            if (offset > BufferSize - MaxVarintSize) {
+                if (!save->WriteRecordData(buffer, offset)) return false;
+                offset = 0;
+            }
+
+            do {
+                uint8_t byte = value & 0x7F;
+                value >>= 7;
+                if (value != 0) byte |= 0x80;
+                buffer[offset++] = byte;
+            } while (value != 0);
+
+            return true;
+        };
+
+        auto endOfRun = [](auto run, auto end) {
+            return std::find_if(run, end, [&](const auto& entry) { return entry.second != run->second; });
+        };
+
+        for (auto group = entries.begin(); group != entries.end();) {
+            const RE::FormID pluginBase{GetPluginBaseOfFormID(group->first)};
+            const auto groupEnd{std::find_if(group, entries.end(), [&](const auto& entry) {
+                return GetPluginBaseOfFormID(entry.first) != pluginBase;
+            })};
+
+            uint32_t runCount = 0;
+            for (auto run = group; run != groupEnd; run = endOfRun(run, groupEnd)) ++runCount;
+
+            if (!writeVarint(pluginBase) || !writeVarint(runCount)) return false;
+
+            for (auto run = group; run != groupEnd;) {
+                const auto runEnd{endOfRun(run, groupEnd)};
+
+                if (!writeVarint(static_cast<uint32_t>(runEnd - run)) || !writeVarint(run->second)) return false;
+
+                RE::FormID previousFormID = pluginBase;
+                for (; run != runEnd; ++run) {
+                    if (!writeVarint(run->first - previousFormID)) return false;
+                    previousFormID = run->first;
+                }
+            }
+
+            group = groupEnd;
+        }
+
+        // Flush any remaining data.
+        if (offset != 0) {
+            if (!save->WriteRecordData(buffer, offset)) return false;
+        }
+
+        logger::info("Saved {} actors to the actor-registry.", entries.size());
+
+        return true;
+    }
+
+    template <typename Serializer>
+    bool ReadRecordDataForActorRegistryV1(Serializer* load, Buffer buffer, const uint32_t length,
+                                          ActorTracker::Registry& registry) {
+        // See `WriteRecordDataForActorRegistryV1` for a description of this format.
+        using ActorState = ActorTracker::ActorState;
+        constexpr auto persistedShift{std::countr_zero(ActorState::PersistedInCosaveMask)};
+
+        size_t offset = 0;
+        size_t remainingBytes = 0;
+
+        auto getMoreBytes = [&]() -> bool {
+            if (remainingBytes == 0) {
+                remainingBytes = load->ReadRecordData(buffer, BufferSize);
+                offset = 0;
+            }
+
+            return remainingBytes != 0;
+        };
+
+        auto readVarint = [&](uint32_t& value) -> bool {
+            value = 0;
+
+            for (uint32_t shift = 0; shift < MaxVarintSize * 7; shift += 7) {
+                if (!getMoreBytes()) return false;
+
+                const uint8_t byte = buffer[offset++];
+                --remainingBytes;
+
+                value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0) return true;
+            }
+
+            return false;
+        };
+
+        // Entries mostly take up a byte or two each, so that's about how many we expect.
+        LoadedActorStates actorStates;
+        actorStates.reserve(length / 2);
+
+        size_t actorCount = 0;
+
+        // The groups run to the end of the record.
+        while (getMoreBytes()) {
+            uint32_t pluginBase;
+            uint32_t runCount;
+            if (!readVarint(pluginBase) || !readVarint(runCount)) goto malformed;
+            if (GetPluginBaseOfFormID(pluginBase) != pluginBase) goto malformed;
+
+            // Every actor in the group belongs to the same plugin, so the group is resolved the once,
+            // and an absent plugin's actors are skipped over.
+            RE::FormID resolvedPluginBase;
+            const bool pluginIsLoaded{load->ResolveFormID(pluginBase, resolvedPluginBase)};
+
+            for (uint32_t run = 0; run < runCount; ++run) {
+                uint32_t entryCount;
+                uint32_t persistedState;
+                if (!readVarint(entryCount) || !readVarint(persistedState)) goto malformed;
+
+                ActorState actorState{};
+                actorState.value = (persistedState << persistedShift) & ActorState::PersistedInCosaveMask;
+
+                RE::FormID formID = pluginBase;
+
+                for (uint32_t entry = 0; entry < entryCount; ++entry) {
+                    uint32_t delta;
+                    if (!readVarint(delta)) goto malformed;
+
+                    formID += delta;
+                    if (GetPluginBaseOfFormID(formID) != pluginBase) goto malformed;
+
+                    ++actorCount;
+
+                    if (pluginIsLoaded) {
+                        const RE::FormID resolvedFormID{resolvedPluginBase | (formID & ~pluginBase)};
+                        actorStates.emplace_back(resolvedFormID, actorState);
+                    }
+                }
+            }
+        }
+
+        logger::info("Loaded {} actors from the actor-registry.", actorCount);
+
+        InsertLoadedActorStates(std::move(actorStates), registry);
+
+        return true;
+    malformed:
+        logger::critical("This save file's actor-registry is malformed! {{remainingBytes: {}}}", remainingBytes);
+        // We keep what we could read, as we do for the v0 format; the rest of the record is lost.
+        logger::warn("Kept the {} actors read from the actor-registry before it became unreadable.",
+                     actorStates.size());
+        InsertLoadedActorStates(std::move(actorStates), registry);
+        return false;
+    }
+
+    template bool WriteRecordDataForActorRegistryV1(SKSE::SerializationInterface* save, Buffer buffer,
+                                                    const ActorTracker::Registry& registry);
+    template bool WriteRecordDataForActorRegistryV1(MemoryRecord* save, Buffer buffer,
+                                                    const ActorTracker::Registry& registry);
+    template bool ReadRecordDataForActorRegistryV1(SKSE::SerializationInterface* load, Buffer buffer, uint32_t length,
+                                                   ActorTracker::Registry& registry);
+    template bool ReadRecordDataForActorRegistryV1(MemoryRecord* load, Buffer buffer, uint32_t length,
+                                                   ActorTracker::Registry& registry);
+
+    bool MemoryRecord::WriteRecordData(const void* a_buffer, const size_t a_length) {
+        const auto* bytes{static_cast<const uint8_t*>(a_buffer)};
+        data.insert(data.end(), bytes, bytes + a_length);
+        return true;
+    }
+
+    uint32_t MemoryRecord::ReadRecordData(void* a_buffer, const size_t a_length) {
+        const auto length{std::min(a_length, data.size() - readOffset)};
+        std::memcpy(a_buffer, data.data() + readOffset, length);
+        readOffset += length;
+        return static_cast<uint32_t>(length);
+    }
+
+    bool MemoryRecord::ResolveFormID(const RE::FormID a_oldFormID, RE::FormID& a_newFormID) const {
+        a_newFormID = a_oldFormID;
+        return true;
+    }
+
+    void InsertLoadedActorStates(LoadedActorStates&& actorStates, ActorTracker::Registry& registry) {
+        [[maybe_unused]] stl::timeit const t;
+
+        // The registry is empty when a save is loaded, as it was reverted beforehand, so we build the table
+        // without any locking, sized the once, and move it in whole.
+        if (registry.stateForActor.empty()) {
+            boost::unordered_flat_map<RE::FormID, ActorTracker::ActorState> stateForActor;
+            stateForActor.reserve(actorStates.size());
+
+            for (const auto& [formID, actorState] : actorStates) stateForActor.insert_or_assign(formID, actorState);
+
+            registry.stateForActor = boost::concurrent_flat_map<RE::FormID, ActorTracker::ActorState>{
+                std::move(stateForActor)};
+            return;
+        }
+
+        registry.stateForActor.reserve(registry.stateForActor.size() + actorStates.size());
+
+        for (const auto& [formID, actorState] : actorStates) {
+            registry.stateForActor.insert_or_assign(formID, actorState);
+        }
+    }
+
     bool WriteRecordDataForPresetNameIndexMapV0(SKSE::SerializationInterface* save, Buffer buffer,
                                                 const PresetManager::PresetContainer& presetContainer) {
         size_t offset = 0;
@@ -2,6 +2,9 @@
 #include "Body/Body.h"
 #include "Body/Event.h"
 #include "Papyrus/Papyrus.h"
+#include "Instrumentation/Instrumentation.h"
+#include "JSONParser/ConfigFile.h"
+#include "JSONParser/ConfigValidationCache.h"
 #include "JSONParser/JSONParser.h"
 #include "PresetManager/PresetManager.h"
 #include "SaveFileState/SaveFileState.h"
@@ -9,6 +12,69 @@
 #include "STL.h"
 
 namespace {
+    struct LoggingSettings {
+        spdlog::level::level_enum level = spdlog::level::info;
+        bool actorLogging = true;
+        // Logging isn't set up yet while the settings are read, so what was wrong with them is logged afterwards.
+        std::vector<std::string> problems;
+    };
+
+    std::string_view Trim(const std::string_view a_string) {
+        const auto begin{a_string.find_first_not_of(" \t\r")};
+        if (begin == std::string_view::npos) return {};
+
+        return a_string.substr(begin, a_string.find_last_not_of(" \t\r") - begin + 1);
+    }
+
+    // The logging is configured in the [Logging] section of OBody.ini, should it exist:
+    //   LogLevel = trace, debug, info, warn, error, critical or off
+    //   ActorLogging = whether to log the lines for each actor that OBody processes, true or false
+    LoggingSettings ReadLoggingSettings() {
+        LoggingSettings settings;
+
+        // The profile functions look for relative paths in the Windows directory, rather than the working one.
+        const auto path{fs::absolute("Data/SKSE/Plugins/OBody.ini").string()};
+
+        // Asked for no key in particular, the profile functions give the names of all the section's keys,
+        // each null-terminated, with an empty name after the last.
+        std::array<char, 4096> keys{};
+        REX::W32::GetPrivateProfileStringA("Logging", nullptr, "", keys.data(), static_cast<uint32_t>(keys.size()),
+                                           path.c_str());
+
+        for (const char* key{keys.data()}; *key != '\0'; key += std::strlen(key) + 1) {
+            std::array<char, 256> buffer{};
+            REX::W32::GetPrivateProfileStringA("Logging", key, "", buffer.data(), static_cast<uint32_t>(buffer.size()),
+                                               path.c_str());
+
+            // Unlike us, the profile functions don't take the rest of a line after a semicolon as a comment.
+            const std::string_view line{buffer.data()};
+            const auto value{Trim(line.substr(0, line.find(';')))};
+
+            if (boost::algorithm::iequals(key, "LogLevel")) {
+                // spdlog takes any name it doesn't know for "off", and we'd rather not lose the log to a typo.
+                const auto level{spdlog::level::from_str(boost::algorithm::to_lower_copy(std::string{value}))};
+                if (level != spdlog::level::off || boost::algorithm::iequals(value, "off")) {
+                    settings.level = level;
+                } else {
+                    settings.problems.push_back(std::format("OBody.ini: unknown LogLevel '{}'.", value));
+                }
+            } else if (boost::algorithm::iequals(key, "ActorLogging")) {
+                if (boost::algorithm::iequals(value, "true") || value == "1") {
+                    settings.actorLogging = true;
+                } else if (boost::algorithm::iequals(value, "false") || value == "0") {
+                    settings.actorLogging = false;
+                } else {
+                    settings.problems.push_back(
+                        std::format("OBody.ini: ActorLogging should be true or false, not '{}'.", value));
+                }
+            } else {
+                settings.problems.push_back(std::format("OBody.ini: unknown key '{}' in the [Logging] section.", key));
+            }
+        }
+
+        return settings;
+    }
+
     void InitializeLogging() {
         // ReSharper disable once CppLocalVariableMayBeConst
         auto path{logger::log_directory()};
@@ -30,9 +96,14 @@ namespace {
         file_sink->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%n] [%l] [%t] [%s:%#] %v");
         log_sinks.emplace_back(file_sink);
 
-        log->set_level(spdlog::level::info);
-        log->flush_on(spdlog::level::info);
+        const auto settings{ReadLoggingSettings()};
+        Instrumentation::actorLogging = settings.actorLogging;
+
+        log->set_level(settings.level);
+        log->flush_on(settings.level);
         spdlog::set_default_logger(std::move(log));
+
+        for (const auto& problem : settings.problems) logger::warn("{}", problem);
     }
 
     // ReSharper disable once CppParameterMayBeConstPtrOrRef
@@ -68,11 +139,14 @@ namespace {
                 auto requestedVersion = request->version;
 
                 switch (requestedVersion) {
-                    case Version::v1: {
+                    // Every version is served by the one implementation, as each version extends the last.
+                    case Version::v1:
+                    case Version::v2: {
                         auto& obody{Body::OBody::GetInstance()};
                         auto& readinessListener = *request->readinessEventListener;
 
-                        *request->pluginInterface = new OBody::API::PluginInterface(a_msg->sender);
+                        *request->pluginInterface =
+                            new OBody::API::PluginInterface(a_msg->sender, nullptr, requestedVersion);
 
                         obody.AttachEventListener(readinessListener);
 
@@ -147,6 +221,9 @@ namespace {
                     parser.bodyslidePresetsParsingValid = false;
                 }
 
+                // The rules refer to the presets directly, so they can only be compiled once we have the presets.
+                parser.CompileRules();
+
                 RE::TESDataHandler* pDataHandler = RE::TESDataHandler::GetSingleton();
 
                 obody.synthesisInstalled = pDataHandler->LookupModByName("SynthEBD.esp") != nullptr;
@@ -249,67 +326,40 @@ SKSEPluginLoad(const SKSE::LoadInterface* a_skse) {
 
     Papyrus::Bind();
     auto& parser{Parser::JSONParser::GetInstance()};
-    rapidjson::Document sd;
-    {
-        stl::FilePtrManager file{"Data/SKSE/Plugins/OBody_presetDistributionConfig_schema.json"};
-        if (file.error() != 0) {
-            SKSE::stl::report_and_fail(
-                "Please Check the Obody.log. Seems like there is a issue with loading the schema");
-        }
-        char readBuffer[65535];
-        rapidjson::FileReadStream bis(file.get(), readBuffer, std::size(readBuffer));
 
-        rapidjson::AutoUTFInputStream<unsigned, rapidjson::FileReadStream> eis(bis);
-        if (sd.ParseStream<0, rapidjson::AutoUTF<unsigned>>(eis).HasParseError()) {
-            logger::info("Error(offset {}): {}", sd.GetErrorOffset(), rapidjson::GetParseError_En(sd.GetParseError()));
-            SKSE::stl::report_and_fail(
-                "Please Check the Obody.log. Seems like there is a issue with loading "
-                "OBody_presetDistributionConfig_schema.json");
-        }
+    const auto schemaJson{ConfigFile::Read(ConfigFile::SchemaPath)};
+    if (!schemaJson) {
+        SKSE::stl::report_and_fail("Please Check the Obody.log. Seems like there is a issue with loading the schema");
     }
-    stl::FilePtrManager file("Data/SKSE/Plugins/OBody_presetDistributionConfig.json");
-    if (file.error() != 0) {
+
+    const auto configJson{ConfigFile::Read(ConfigFile::ConfigPath)};
+    if (!configJson) {
         SKSE::stl::report_and_fail(
             "Please Check the Obody.log. Seems like there is a issue with loading OBody_presetDistributionConfig.json");
     }
-    rapidjson::SchemaDocument schema(sd);
-    char readBuffer[65535];
-    rapidjson::FileReadStream bis(file.get(), readBuffer, std::size(readBuffer));
 
-    rapidjson::AutoUTFInputStream<unsigned, rapidjson::FileReadStream> eis(bis);
-    if (parser.presetDistributionConfig.ParseStream<0, rapidjson::AutoUTF<unsigned>>(eis).HasParseError()) {
+    if (ConfigFile::Parse(parser.presetDistributionConfig, *configJson).HasParseError()) {
         logger::info("Config Error(offset {}): {}", parser.presetDistributionConfig.GetErrorOffset(),
                      rapidjson::GetParseError_En(parser.presetDistributionConfig.GetParseError()));
         SKSE::stl::report_and_fail(
             "Please Check the Obody.log. Seems like there is an error when parsing "
             "OBody_presetDistributionConfig.json");
     }
-    if (rapidjson::SchemaValidator validator(schema); !parser.presetDistributionConfig.Accept(validator)) {
-        rapidjson::StringBuffer sb;
-        const auto invalidSchemaPointer = validator.GetInvalidSchemaPointer();
-        invalidSchemaPointer.StringifyUriFragment(sb);
-        logger::error("Invalid schema: {}", sb.GetString());
-        logger::error("Invalid keyword: {}", validator.GetInvalidSchemaKeyword());
-        sb.Clear();
-        const auto invalidDocumentPointer = validator.GetInvalidDocumentPointer();
-        invalidDocumentPointer.StringifyUriFragment(sb);
-        logger::error("Invalid document: {}", sb.GetString());
-        sb.Clear();
-        if (auto* err_value_ptr = invalidDocumentPointer.Get(parser.presetDistributionConfig)) {
-            rapidjson::PrettyWriter writer(sb);
-            err_value_ptr->Accept(writer);
-            logger::error("Error at: {}", sb.GetString());
-            sb.Clear();
-        }
-        if (auto* err_values_schema_pointer = invalidSchemaPointer.Get(sd)) {
-            rapidjson::PrettyWriter writer(sb);
-            err_values_schema_pointer->Accept(writer);
-            logger::error("Schema Definition of Error: {}", sb.GetString());
+
+    parser.presetDistributionConfigFingerprint = ConfigValidationCache::ComputeFingerprint(*configJson, *schemaJson);
+    if (ConfigValidationCache::IsValidated(parser.presetDistributionConfigFingerprint)) {
+        logger::info("Data/SKSE/Plugins/OBody_presetDistributionConfig.json is unchanged since it was last validated");
+    } else {
+        if (!ConfigFile::Validate(parser.presetDistributionConfig, *schemaJson)) {
+            SKSE::stl::report_and_fail(
+                "Please Check the Obody.log. Seems like there is an error when validating the config using the json "
+                "schema");
         }
-        SKSE::stl::report_and_fail(
-            "Please Check the Obody.log. Seems like there is an error when validating the config using the json schema");
+
+        ConfigValidationCache::SaveValidated(parser.presetDistributionConfigFingerprint);
+        logger::info("Validated Data/SKSE/Plugins/OBody_presetDistributionConfig.json successfully");
     }
-    logger::info("Validated Data/SKSE/Plugins/OBody_presetDistributionConfig.json successfully");
+
     logger::info("{} has finished loading.", plugin->GetName());
 
     return true;
@@ -23,6 +23,13 @@ add_rules("plugin.vsxmake.autoupdate")
 -- set default mode to releasedbg
 set_defaultmode("releasedbg")
 
+-- add options
+option("actor_logging")
+    set_default(true)
+    set_showmenu(true)
+    set_description("Log a line for each actor that OBody processes. Disabling it compiles those lines out.")
+option_end()
+
 -- require packages
 add_requires("rapidjson", "pugixml")
 local cfg = {
@@ -46,6 +53,7 @@ target("OBody")
     -- add packages to target
     add_packages("rapidjson", "pugixml", "vcpkg::ryml", "vcpkg::boost-algorithm")
     add_defines("SPDLOG_ACTIVE_LEVEL=SPDLOG_LEVEL_TRACE")
+    add_defines(has_config("actor_logging") and "OBODY_ACTOR_LOGGING=1" or "OBODY_ACTOR_LOGGING=0")
 
     -- add commonlibsse-ng plugin
     add_rules("commonlibsse-ng.plugin", {